@@ -0,0 +1,108 @@
+// throughput of sunder_suballocate_from_arena_concurrent on one shared arena for 1 to N threads
+// usage: bench_concurrent_suballocation [max thread count] [suballocations per thread]
+
+#include "snd_lib.h"
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+
+#define SUNDER_BENCH_SUBALLOCATION_SIZE 48u
+#define SUNDER_BENCH_SUBALLOCATION_ALIGNMENT 16u
+#define SUNDER_BENCH_MAX_THREAD_COUNT 64u
+
+struct sunder_bench_worker_t
+{
+	sunder_arena_t* arena = nullptr;
+	std::atomic<bool>* start = nullptr;
+	u64 suballocation_count = 0;
+	u64 failure_count = 0;
+};
+
+SUNDER_INTERNAL void sunder_bench_suballocate(void* args)
+{
+	sunder_bench_worker_t* worker = (sunder_bench_worker_t*)args;
+
+	while (!worker->start->load(std::memory_order_acquire)) { std::this_thread::yield(); }
+
+	for (u64 i = 0; i < worker->suballocation_count; i++)
+	{
+		const sunder_arena_suballocation_result_t res = sunder_suballocate_from_arena_concurrent(worker->arena, SUNDER_BENCH_SUBALLOCATION_SIZE, SUNDER_BENCH_SUBALLOCATION_ALIGNMENT);
+
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS)
+		{
+			worker->failure_count++;
+			continue;
+		}
+
+		*(u8*)res.data = (u8)i;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const u32 hardware_thread_count = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1u;
+	u32 max_thread_count = argc > 1 ? (u32)strtoul(argv[1], nullptr, 10) : hardware_thread_count;
+	const u64 suballocations_per_thread = argc > 2 ? strtoull(argv[2], nullptr, 10) : 250000ull;
+
+	if (max_thread_count == 0) { max_thread_count = 1; }
+	if (max_thread_count > SUNDER_BENCH_MAX_THREAD_COUNT) { max_thread_count = SUNDER_BENCH_MAX_THREAD_COUNT; }
+
+	// room for the largest run, every suballocation rounds up to a multiple of the alignment
+	const u64 stride = (SUNDER_BENCH_SUBALLOCATION_SIZE + SUNDER_BENCH_SUBALLOCATION_ALIGNMENT - 1) / SUNDER_BENCH_SUBALLOCATION_ALIGNMENT * SUNDER_BENCH_SUBALLOCATION_ALIGNMENT;
+	const u64 capacity = stride * suballocations_per_thread * max_thread_count;
+
+	sunder_arena_t arena;
+
+	if (sunder_allocate_arena(&arena, capacity, 64) != SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		printf("failed to allocate a %llu byte arena\n", (unsigned long long)capacity);
+		return 1;
+	}
+
+	sunder_initialize_time();
+	printf("hardware threads: %u, suballocations per thread: %llu\n", hardware_thread_count, (unsigned long long)suballocations_per_thread);
+	printf("%8s %14s %14s %10s\n", "threads", "seconds", "Msuballoc/s", "speedup");
+
+	f64 single_thread_rate = 0.0;
+
+	for (u32 thread_count = 1; thread_count <= max_thread_count; thread_count++)
+	{
+		sunder_reset_arena(&arena);
+
+		std::atomic<bool> start{ false };
+		sunder_thread_t threads[SUNDER_BENCH_MAX_THREAD_COUNT];
+		sunder_bench_worker_t workers[SUNDER_BENCH_MAX_THREAD_COUNT];
+
+		for (u32 i = 0; i < thread_count; i++)
+		{
+			workers[i].arena = &arena;
+			workers[i].start = &start;
+			workers[i].suballocation_count = suballocations_per_thread;
+			sunder_launch_thread(&threads[i], sunder_bench_suballocate, &workers[i]);
+		}
+
+		const f64 begin = sunder_get_elapsed_time_in_seconds();
+		start.store(true, std::memory_order_release);
+
+		for (u32 i = 0; i < thread_count; i++)
+		{
+			sunder_join_thread(&threads[i]);
+		}
+
+		const f64 seconds = sunder_get_elapsed_time_in_seconds() - begin;
+
+		u64 failure_count = 0;
+		for (u32 i = 0; i < thread_count; i++) { failure_count += workers[i].failure_count; }
+
+		const f64 rate = (f64)(suballocations_per_thread * thread_count) / seconds;
+		if (thread_count == 1) { single_thread_rate = rate; }
+
+		printf("%8u %14.6f %14.2f %9.2fx", thread_count, seconds, rate / 1e6, rate / single_thread_rate);
+		if (failure_count > 0) { printf(" (%llu failed)", (unsigned long long)failure_count); }
+		printf("\n");
+	}
+
+	sunder_free_arena(&arena);
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+// throughput of sunder_copy_buffer against memcpy (and memmove for overlapping ranges) from 64 bytes up to the largest size
+// usage: bench_copy_buffer [largest size in MiB]
+
+#include "snd_lib.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define SUNDER_BENCH_BYTES_PER_MEASUREMENT (1ull << 30)
+#define SUNDER_BENCH_MIN_REPETITIONS 4ull
+
+// the source and destination offsets of a case, 0 keeps both buffers 64 byte aligned
+struct sunder_bench_copy_case_t
+{
+	const char* name = nullptr;
+	u64 dst_offset = 0;
+	u64 src_offset = 0;
+	bool overlapping = false;
+};
+
+SUNDER_INTERNAL volatile u8 sunder_bench_sink = 0;
+
+SUNDER_INTERNAL f64 sunder_bench_measure_copy(u8* dst, const u8* src, u64 bytes, u64 repetitions, bool use_sunder, bool overlapping)
+{
+	sunder_buffer_copy_data_t copying_data;
+	copying_data.dst_size = bytes;
+	copying_data.src_size = bytes;
+	copying_data.bytes_to_write = bytes;
+
+	const f64 begin = sunder_get_elapsed_time_in_seconds();
+
+	for (u64 i = 0; i < repetitions; i++)
+	{
+		if (use_sunder) { sunder_copy_buffer(dst, src, &copying_data); }
+		else if (overlapping) { memmove(dst, src, bytes); }
+		else { memcpy(dst, src, bytes); }
+
+		sunder_bench_sink = sunder_bench_sink + dst[i % bytes];
+	}
+
+	const f64 seconds = sunder_get_elapsed_time_in_seconds() - begin;
+
+	return (f64)(bytes * repetitions) / seconds / (1024.0 * 1024.0 * 1024.0);
+}
+
+int main(int argc, char** argv)
+{
+	const u64 largest_size = (argc > 1 ? strtoull(argv[1], nullptr, 10) : 64ull) * 1024ull * 1024ull;
+	if (largest_size == 0) { printf("the largest size has to be at least 1 MiB\n"); return 1; }
+
+	// room for the misaligned cases and for the overlapping one, which copies within a single buffer
+	u8* src = (u8*)sunder_aligned_halloc(largest_size + 128, 64);
+	u8* dst = (u8*)sunder_aligned_halloc(largest_size * 2 + 128, 64);
+
+	if (src == nullptr || dst == nullptr)
+	{
+		printf("failed to allocate the benchmark buffers\n");
+		return 1;
+	}
+
+	memset(src, 0x5A, largest_size + 128);
+	memset(dst, 0, largest_size * 2 + 128);
+
+	const sunder_bench_copy_case_t cases[] =
+	{
+		{ "aligned", 0, 0, false },
+		{ "misaligned", 1, 3, false },
+		{ "overlapping", 0, 0, true }
+	};
+
+	sunder_initialize_time();
+	printf("%-12s %12s %14s %14s %8s\n", "case", "bytes", "sunder GiB/s", "libc GiB/s", "ratio");
+
+	for (const sunder_bench_copy_case_t& copy_case : cases)
+	{
+		for (u64 bytes = 64; bytes <= largest_size; bytes *= 4)
+		{
+			u64 repetitions = SUNDER_BENCH_BYTES_PER_MEASUREMENT / bytes;
+			if (repetitions < SUNDER_BENCH_MIN_REPETITIONS) { repetitions = SUNDER_BENCH_MIN_REPETITIONS; }
+
+			// overlapping copies shift a range up by a quarter of its size inside dst, the direction memcpy would get wrong
+			u8* case_dst = dst + copy_case.dst_offset + (copy_case.overlapping ? bytes / 4 : 0);
+			const u8* case_src = copy_case.overlapping ? dst : src + copy_case.src_offset;
+
+			// warm up both paths once so page faults and cache misses of the first touch are not measured
+			sunder_bench_measure_copy(case_dst, case_src, bytes, 1, true, copy_case.overlapping);
+			sunder_bench_measure_copy(case_dst, case_src, bytes, 1, false, copy_case.overlapping);
+
+			const f64 sunder_rate = sunder_bench_measure_copy(case_dst, case_src, bytes, repetitions, true, copy_case.overlapping);
+			const f64 libc_rate = sunder_bench_measure_copy(case_dst, case_src, bytes, repetitions, false, copy_case.overlapping);
+
+			printf("%-12s %12llu %14.2f %14.2f %7.2fx\n", copy_case.name, (unsigned long long)bytes, sunder_rate, libc_rate, sunder_rate / libc_rate);
+		}
+	}
+
+	sunder_aligned_free((void**)&src);
+	sunder_aligned_free((void**)&dst);
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+// sunder_parallel_sort_u32 / _f64 over the same random input for 1 to N threads
+// usage: bench_parallel_sort [max thread count] [element count]
+
+#include "snd_lib.h"
+#include <cstdio>
+#include <cstdlib>
+
+SUNDER_INTERNAL u64 sunder_bench_next_random(u64* state)
+{
+	// xorshift64, every thread count sorts the exact same sequence
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+SUNDER_INTERNAL void sunder_bench_fill_u32(u32* buffer, u64 element_count)
+{
+	u64 state = 0x9E3779B97F4A7C15ull;
+	for (u64 i = 0; i < element_count; i++) { buffer[i] = (u32)sunder_bench_next_random(&state); }
+}
+
+SUNDER_INTERNAL void sunder_bench_fill_f64(f64* buffer, u64 element_count)
+{
+	u64 state = 0x9E3779B97F4A7C15ull;
+	for (u64 i = 0; i < element_count; i++) { buffer[i] = (f64)(sunder_bench_next_random(&state) >> 11) * (1.0 / 9007199254740992.0) - 0.5; }
+}
+
+template<typename type>
+SUNDER_INTERNAL bool sunder_bench_is_sorted(const type* buffer, u64 element_count)
+{
+	for (u64 i = 1; i < element_count; i++)
+	{
+		if (buffer[i] < buffer[i - 1]) { return false; }
+	}
+
+	return true;
+}
+
+SUNDER_INTERNAL void sunder_bench_print_row(const char* type_name, u32 thread_count, f64 seconds, f64 single_thread_seconds, u64 element_count, bool sorted)
+{
+	printf("%-5s %8u %12.4f %14.2f %9.2fx%s\n", type_name, thread_count, seconds, (f64)element_count / seconds / 1e6, single_thread_seconds / seconds, sorted ? "" : "  NOT SORTED");
+}
+
+int main(int argc, char** argv)
+{
+	const u32 hardware_thread_count = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1u;
+	u32 max_thread_count = argc > 1 ? (u32)strtoul(argv[1], nullptr, 10) : hardware_thread_count;
+	const u64 element_count = argc > 2 ? strtoull(argv[2], nullptr, 10) : 16ull * 1024ull * 1024ull;
+
+	if (max_thread_count == 0) { max_thread_count = 1; }
+	if (max_thread_count > SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT) { max_thread_count = SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT; }
+
+	u32* keys_u32 = (u32*)sunder_aligned_halloc(sizeof(u32), element_count, 64);
+	f64* keys_f64 = (f64*)sunder_aligned_halloc(sizeof(f64), element_count, 64);
+
+	// the scratch holds one copy of the widest keys, the virtual memory backend only commits what a run touches
+	sunder_arena_allocation_data_t scratch_data;
+	scratch_data.arena_allocation_size = sizeof(f64) * element_count + 1024ull * 1024ull;
+	scratch_data.arena_allocation_alignment = 64;
+	scratch_data.flags = SUNDER_BIT_TO_MASK(SUNDER_ARENA_BITS_VIRTUAL_MEMORY_BACKEND_BIT, 1u);
+
+	sunder_arena_t scratch_arena;
+
+	if (keys_u32 == nullptr || keys_f64 == nullptr || sunder_allocate_arena(&scratch_arena, &scratch_data) != SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		printf("failed to allocate %llu elements\n", (unsigned long long)element_count);
+		return 1;
+	}
+
+	sunder_initialize_time();
+	printf("hardware threads: %u, elements: %llu\n", hardware_thread_count, (unsigned long long)element_count);
+	printf("%-5s %8s %12s %14s %10s\n", "type", "threads", "seconds", "Melements/s", "speedup");
+
+	f64 single_thread_seconds_u32 = 0.0;
+	f64 single_thread_seconds_f64 = 0.0;
+
+	for (u32 thread_count = 1; thread_count <= max_thread_count; thread_count++)
+	{
+		sunder_bench_fill_u32(keys_u32, element_count);
+
+		f64 begin = sunder_get_elapsed_time_in_seconds();
+		sunder_arena_result result = sunder_parallel_sort_u32(keys_u32, element_count, thread_count, &scratch_arena);
+		const f64 seconds_u32 = sunder_get_elapsed_time_in_seconds() - begin;
+
+		if (result != SUNDER_ARENA_RESULT_SUCCESS) { printf("sunder_parallel_sort_u32 failed with %u\n", (u32)result); return 1; }
+		if (thread_count == 1) { single_thread_seconds_u32 = seconds_u32; }
+		sunder_bench_print_row("u32", thread_count, seconds_u32, single_thread_seconds_u32, element_count, sunder_bench_is_sorted(keys_u32, element_count));
+
+		sunder_bench_fill_f64(keys_f64, element_count);
+
+		begin = sunder_get_elapsed_time_in_seconds();
+		result = sunder_parallel_sort_f64(keys_f64, element_count, thread_count, &scratch_arena);
+		const f64 seconds_f64 = sunder_get_elapsed_time_in_seconds() - begin;
+
+		if (result != SUNDER_ARENA_RESULT_SUCCESS) { printf("sunder_parallel_sort_f64 failed with %u\n", (u32)result); return 1; }
+		if (thread_count == 1) { single_thread_seconds_f64 = seconds_f64; }
+		sunder_bench_print_row("f64", thread_count, seconds_f64, single_thread_seconds_f64, element_count, sunder_bench_is_sorted(keys_f64, element_count));
+	}
+
+	sunder_free_arena(&scratch_arena);
+	sunder_aligned_free((void**)&keys_u32);
+	sunder_aligned_free((void**)&keys_f64);
+
+	return 0;
+}
@@ -1,5 +1,30 @@
 #include "snd_lib.h"
 #include <ctime>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SUNDER_X86
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define SUNDER_TARGET_AVX2
+#else
+#define SUNDER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
 
 void* sunder_halloc(u64 type_size_in_bytes, u64 element_count)
 {
@@ -25,26 +50,140 @@ void* sunder_halloc(u64 bytes)
 	return nullptr;
 }
 
-void* sunder_aligned_halloc(u64 type_size_in_bytes, u64 element_count, u64 alignment)
+// every aligned block is preceded by this header, the distance to base is the effective alignment so the header always fits
+struct sunder_aligned_block_header_t
 {
-	if (type_size_in_bytes ==  0 || alignment == 0 || element_count == 0) { return nullptr; }
+	void* base = nullptr;
+	u32 size_class = 0;
+	u32 alignment = 0;
+};
+
+struct sunder_aligned_halloc_thread_cache_t
+{
+	void* blocks[SUNDER_ALIGNED_HALLOC_SIZE_CLASS_COUNT][SUNDER_ALIGNED_HALLOC_THREAD_CACHE_CAPACITY];
+	u32 block_counts[SUNDER_ALIGNED_HALLOC_SIZE_CLASS_COUNT];
+	bool released;
+};
+
+// flushes the cache on thread exit, the cache itself is trivially destructible so frees from later thread_local destructors still see it
+struct sunder_aligned_halloc_thread_cache_release_t
+{
+	~sunder_aligned_halloc_thread_cache_release_t();
+};
+
+SUNDER_INTERNAL thread_local sunder_aligned_halloc_thread_cache_t sunder_aligned_halloc_thread_cache{};
+SUNDER_INTERNAL thread_local sunder_aligned_halloc_thread_cache_release_t sunder_aligned_halloc_thread_cache_release;
+
+SUNDER_INTERNAL void* sunder_default_aligned_allocate_internal(u64 bytes, u64 alignment, void* user_data)
+{
+	(void)user_data;
+
+#if defined(_WIN32)
+	return _aligned_malloc(bytes, alignment);
+#else
+	void* memblock = nullptr;
+	if (posix_memalign(&memblock, alignment, bytes) != 0) { return nullptr; }
 
-	void* memblock = _aligned_malloc(type_size_in_bytes * element_count, alignment);
-	if (memblock == NULL) { memblock = nullptr; }
-		
 	return memblock;
+#endif
 }
 
-void* sunder_aligned_halloc(u64 bytes, u64 alignment)
+SUNDER_INTERNAL void sunder_default_aligned_free_internal(void* memblock, void* user_data)
+{
+	(void)user_data;
+
+#if defined(_WIN32)
+	_aligned_free(memblock);
+#else
+	free(memblock);
+#endif
+}
+
+SUNDER_INTERNAL sunder_aligned_allocation_backend_t sunder_aligned_allocation_backend = { sunder_default_aligned_allocate_internal, sunder_default_aligned_free_internal, nullptr };
+
+SUNDER_INTERNAL sunder_aligned_block_header_t* sunder_get_aligned_block_header_internal(void* memblock)
 {
-	if (bytes < 0 || alignment == 0) { return nullptr; }
+	return (sunder_aligned_block_header_t*)((u8*)memblock - sizeof(sunder_aligned_block_header_t));
+}
+
+SUNDER_INTERNAL void* sunder_aligned_halloc_internal(u64 bytes, u64 alignment)
+{
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0) { return nullptr; }
+
+	const u64 working_alignment = alignment < sizeof(sunder_aligned_block_header_t) ? sizeof(sunder_aligned_block_header_t) : alignment;
+
+	// size classes are powers of 2, anything above the largest class goes straight to the backend every time
+	u32 size_class = UINT32_MAX;
+	u64 block_size = bytes;
+
+	if (bytes <= (1ull << (SUNDER_ALIGNED_HALLOC_MIN_SIZE_CLASS_SHIFT + SUNDER_ALIGNED_HALLOC_SIZE_CLASS_COUNT - 1)))
+	{
+		size_class = 0;
+		while ((1ull << (SUNDER_ALIGNED_HALLOC_MIN_SIZE_CLASS_SHIFT + size_class)) < bytes) { size_class++; }
+		block_size = 1ull << (SUNDER_ALIGNED_HALLOC_MIN_SIZE_CLASS_SHIFT + size_class);
+
+		sunder_aligned_halloc_thread_cache_t* cache = &sunder_aligned_halloc_thread_cache;
 
-	void* memblock = _aligned_malloc(bytes, alignment);
-	if (memblock == NULL) { memblock = nullptr; }
+		for (u32 i = cache->block_counts[size_class]; i > 0; i--)
+		{
+			void* cached = cache->blocks[size_class][i - 1];
+			if (sunder_get_aligned_block_header_internal(cached)->alignment < working_alignment) { continue; }
+
+			cache->blocks[size_class][i - 1] = cache->blocks[size_class][cache->block_counts[size_class] - 1];
+			cache->block_counts[size_class]--;
+			return cached;
+		}
+	}
+
+	u8* base = (u8*)sunder_aligned_allocation_backend.allocate(block_size + working_alignment, working_alignment, sunder_aligned_allocation_backend.user_data);
+	if (base == nullptr) { return nullptr; }
+
+	u8* memblock = base + working_alignment;
+	sunder_aligned_block_header_t* header = sunder_get_aligned_block_header_internal(memblock);
+	header->base = base;
+	header->size_class = size_class;
+	header->alignment = (u32)working_alignment;
 
 	return memblock;
 }
 
+SUNDER_INTERNAL void sunder_aligned_free_internal(void* memblock)
+{
+	const sunder_aligned_block_header_t* header = sunder_get_aligned_block_header_internal(memblock);
+	sunder_aligned_halloc_thread_cache_t* cache = &sunder_aligned_halloc_thread_cache;
+
+	if (header->size_class != UINT32_MAX && !cache->released && cache->block_counts[header->size_class] < SUNDER_ALIGNED_HALLOC_THREAD_CACHE_CAPACITY)
+	{
+		// touching the release object registers its destructor for this thread
+		(void)&sunder_aligned_halloc_thread_cache_release;
+
+		cache->blocks[header->size_class][cache->block_counts[header->size_class]++] = memblock;
+		return;
+	}
+
+	sunder_aligned_allocation_backend.free(header->base, sunder_aligned_allocation_backend.user_data);
+}
+
+sunder_aligned_halloc_thread_cache_release_t::~sunder_aligned_halloc_thread_cache_release_t()
+{
+	sunder_flush_aligned_halloc_thread_cache();
+	sunder_aligned_halloc_thread_cache.released = true;
+}
+
+void* sunder_aligned_halloc(u64 type_size_in_bytes, u64 element_count, u64 alignment)
+{
+	if (type_size_in_bytes ==  0 || alignment == 0 || element_count == 0) { return nullptr; }
+
+	return sunder_aligned_halloc_internal(type_size_in_bytes * element_count, alignment);
+}
+
+void* sunder_aligned_halloc(u64 bytes, u64 alignment)
+{
+	if (alignment == 0) { return nullptr; }
+
+	return sunder_aligned_halloc_internal(bytes, alignment);
+}
+
 void sunder_free(void** memblock)
 {
 	if (memblock == nullptr) { return; }
@@ -62,11 +201,39 @@ void sunder_aligned_free(void** memblock)
 
 	if (*memblock != nullptr)
 	{
-		_aligned_free(*memblock);
+		sunder_aligned_free_internal(*memblock);
 		*memblock = nullptr;
 	}
 }
 
+void sunder_set_aligned_allocation_backend(const sunder_aligned_allocation_backend_t* backend)
+{
+	sunder_flush_aligned_halloc_thread_cache();
+
+	if (backend == nullptr || backend->allocate == nullptr || backend->free == nullptr)
+	{
+		sunder_aligned_allocation_backend = { sunder_default_aligned_allocate_internal, sunder_default_aligned_free_internal, nullptr };
+		return;
+	}
+
+	sunder_aligned_allocation_backend = *backend;
+}
+
+void sunder_flush_aligned_halloc_thread_cache()
+{
+	sunder_aligned_halloc_thread_cache_t* cache = &sunder_aligned_halloc_thread_cache;
+
+	for (u32 size_class = 0; size_class < SUNDER_ALIGNED_HALLOC_SIZE_CLASS_COUNT; size_class++)
+	{
+		for (u32 i = 0; i < cache->block_counts[size_class]; i++)
+		{
+			sunder_aligned_allocation_backend.free(sunder_get_aligned_block_header_internal(cache->blocks[size_class][i])->base, sunder_aligned_allocation_backend.user_data);
+		}
+
+		cache->block_counts[size_class] = 0;
+	}
+}
+
 bool sunder_is_valid(const void* memblock)
 {
 	return memblock != nullptr;
@@ -119,326 +286,4024 @@ u64 sunder_rand_u64(u64 start, u64 end)
 	return rand() % (diapason + 1) + start;
 }
 
-u64 sunder_copy_buffer(void* dst, const void* src, const sunder_buffer_copy_data_t* copying_data)
+struct sunder_cpu_features_t
 {
-	if (dst == nullptr) { return 0; }
-	if (src == nullptr) { return 0; }
+	bool avx2 = false;
+	u64 last_level_cache_size = SUNDER_DEFAULT_LAST_LEVEL_CACHE_SIZE;
+};
+
+SUNDER_INTERNAL sunder_cpu_features_t sunder_detect_cpu_features_internal()
+{
+	sunder_cpu_features_t features;
 
-	i8* temp_bytes_to_copy_to = (i8*)dst;
-	i8* temp_bytes_to_copy = (i8*)src;
+#if defined(SUNDER_X86) && defined(_MSC_VER)
+	i32 registers[4]{};
+	__cpuid(registers, 0);
 
-	if (copying_data->bytes_to_write > copying_data->dst_size || copying_data->bytes_to_write > copying_data->src_size || copying_data->bytes_to_write == 0) { return 0; }
+	if (registers[0] >= 7)
+	{
+		__cpuid(registers, 1);
+		const bool os_saves_ymm = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
 
-		for (u64 i = 0; i < copying_data->bytes_to_write; i++)
-		{
-			temp_bytes_to_copy_to[i + copying_data->dst_offset] = temp_bytes_to_copy[i + copying_data->src_offset];
-		}
+		__cpuidex(registers, 7, 0);
+		features.avx2 = os_saves_ymm && (registers[1] & (1 << 5)) != 0;
+	}
+#elif defined(SUNDER_X86)
+	__builtin_cpu_init();
+	features.avx2 = __builtin_cpu_supports("avx2");
+#endif
 
-	return copying_data->bytes_to_write;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+	const long last_level_cache_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+	if (last_level_cache_size > 0) { features.last_level_cache_size = (u64)last_level_cache_size; }
+#endif
+
+	return features;
 }
 
-bool sunder_is_even(u64 val)
+// until this dynamic initializer has run the object is zero initialized: copies and fills issued by earlier static initializers see avx2 == false
+// and last_level_cache_size == 0, the latter is read through sunder_get_non_temporal_threshold_internal so they still use regular stores
+SUNDER_INTERNAL const sunder_cpu_features_t sunder_cpu_features = sunder_detect_cpu_features_internal();
+
+// copies and fills above the last level cache size bypass it with non temporal stores
+SUNDER_INTERNAL u64 sunder_get_non_temporal_threshold_internal()
 {
-	return val % 2 == 0;
+	return sunder_cpu_features.last_level_cache_size > 0 ? sunder_cpu_features.last_level_cache_size : SUNDER_DEFAULT_LAST_LEVEL_CACHE_SIZE;
 }
 
-bool sunder_is_power_of_2(u64 val)
+#if defined(SUNDER_X86)
+// head and tail vectors are loaded before anything is stored and every loop step loads before it stores, which keeps overlapping copies correct in either direction
+SUNDER_INTERNAL void sunder_copy_bytes_sse2_internal(u8* dst, const u8* src, u64 bytes, bool non_temporal)
 {
-	return val != 0 && (val & (val - 1)) == 0;
+	const __m128i head = _mm_loadu_si128((const __m128i*)src);
+	const __m128i tail = _mm_loadu_si128((const __m128i*)(src + bytes - 16));
+
+	if (dst <= src || dst >= src + bytes)
+	{
+		u64 i = sunder_align64((u64)dst, 16) - (u64)dst;
+		if (i == 0) { i = 16; }
+
+		for (; i + 64 <= bytes - 16; i += 64)
+		{
+			const __m128i v0 = _mm_loadu_si128((const __m128i*)(src + i));
+			const __m128i v1 = _mm_loadu_si128((const __m128i*)(src + i + 16));
+			const __m128i v2 = _mm_loadu_si128((const __m128i*)(src + i + 32));
+			const __m128i v3 = _mm_loadu_si128((const __m128i*)(src + i + 48));
+
+			if (non_temporal)
+			{
+				_mm_stream_si128((__m128i*)(dst + i), v0);
+				_mm_stream_si128((__m128i*)(dst + i + 16), v1);
+				_mm_stream_si128((__m128i*)(dst + i + 32), v2);
+				_mm_stream_si128((__m128i*)(dst + i + 48), v3);
+			}
+			else
+			{
+				_mm_store_si128((__m128i*)(dst + i), v0);
+				_mm_store_si128((__m128i*)(dst + i + 16), v1);
+				_mm_store_si128((__m128i*)(dst + i + 32), v2);
+				_mm_store_si128((__m128i*)(dst + i + 48), v3);
+			}
+		}
+
+		for (; i < bytes - 16; i += 16)
+		{
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_loadu_si128((const __m128i*)(src + i)));
+		}
+
+		if (non_temporal) { _mm_sfence(); }
+	}
+	else
+	{
+		u64 end = bytes - ((u64)(dst + bytes) & 15u);
+		if (end == bytes) { end = bytes - 16; }
+
+		for (; end >= 64 + 16; end -= 64)
+		{
+			const __m128i v0 = _mm_loadu_si128((const __m128i*)(src + end - 16));
+			const __m128i v1 = _mm_loadu_si128((const __m128i*)(src + end - 32));
+			const __m128i v2 = _mm_loadu_si128((const __m128i*)(src + end - 48));
+			const __m128i v3 = _mm_loadu_si128((const __m128i*)(src + end - 64));
+
+			_mm_store_si128((__m128i*)(dst + end - 16), v0);
+			_mm_store_si128((__m128i*)(dst + end - 32), v1);
+			_mm_store_si128((__m128i*)(dst + end - 48), v2);
+			_mm_store_si128((__m128i*)(dst + end - 64), v3);
+		}
+
+		for (; end > 16; end -= 16)
+		{
+			_mm_storeu_si128((__m128i*)(dst + end - 16), _mm_loadu_si128((const __m128i*)(src + end - 16)));
+		}
+	}
+
+	_mm_storeu_si128((__m128i*)dst, head);
+	_mm_storeu_si128((__m128i*)(dst + bytes - 16), tail);
 }
 
-u64 sunder_align64(u64 current_offset, u64 alignment)
+SUNDER_TARGET_AVX2 SUNDER_INTERNAL void sunder_copy_bytes_avx2_internal(u8* dst, const u8* src, u64 bytes, bool non_temporal)
 {
-	return (current_offset + alignment - 1) & ~(alignment - 1);
+	const __m256i head = _mm256_loadu_si256((const __m256i*)src);
+	const __m256i tail = _mm256_loadu_si256((const __m256i*)(src + bytes - 32));
+
+	if (dst <= src || dst >= src + bytes)
+	{
+		u64 i = sunder_align64((u64)dst, 32) - (u64)dst;
+		if (i == 0) { i = 32; }
+
+		for (; i + 128 <= bytes - 32; i += 128)
+		{
+			const __m256i v0 = _mm256_loadu_si256((const __m256i*)(src + i));
+			const __m256i v1 = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+			const __m256i v2 = _mm256_loadu_si256((const __m256i*)(src + i + 64));
+			const __m256i v3 = _mm256_loadu_si256((const __m256i*)(src + i + 96));
+
+			if (non_temporal)
+			{
+				_mm256_stream_si256((__m256i*)(dst + i), v0);
+				_mm256_stream_si256((__m256i*)(dst + i + 32), v1);
+				_mm256_stream_si256((__m256i*)(dst + i + 64), v2);
+				_mm256_stream_si256((__m256i*)(dst + i + 96), v3);
+			}
+			else
+			{
+				_mm256_store_si256((__m256i*)(dst + i), v0);
+				_mm256_store_si256((__m256i*)(dst + i + 32), v1);
+				_mm256_store_si256((__m256i*)(dst + i + 64), v2);
+				_mm256_store_si256((__m256i*)(dst + i + 96), v3);
+			}
+		}
+
+		for (; i < bytes - 32; i += 32)
+		{
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_loadu_si256((const __m256i*)(src + i)));
+		}
+
+		if (non_temporal) { _mm_sfence(); }
+	}
+	else
+	{
+		u64 end = bytes - ((u64)(dst + bytes) & 31u);
+		if (end == bytes) { end = bytes - 32; }
+
+		for (; end >= 128 + 32; end -= 128)
+		{
+			const __m256i v0 = _mm256_loadu_si256((const __m256i*)(src + end - 32));
+			const __m256i v1 = _mm256_loadu_si256((const __m256i*)(src + end - 64));
+			const __m256i v2 = _mm256_loadu_si256((const __m256i*)(src + end - 96));
+			const __m256i v3 = _mm256_loadu_si256((const __m256i*)(src + end - 128));
+
+			_mm256_store_si256((__m256i*)(dst + end - 32), v0);
+			_mm256_store_si256((__m256i*)(dst + end - 64), v1);
+			_mm256_store_si256((__m256i*)(dst + end - 96), v2);
+			_mm256_store_si256((__m256i*)(dst + end - 128), v3);
+		}
+
+		for (; end > 32; end -= 32)
+		{
+			_mm256_storeu_si256((__m256i*)(dst + end - 32), _mm256_loadu_si256((const __m256i*)(src + end - 32)));
+		}
+	}
+
+	_mm256_storeu_si256((__m256i*)dst, head);
+	_mm256_storeu_si256((__m256i*)(dst + bytes - 32), tail);
+
+	// avoids the avx to sse transition penalty in whatever runs next
+	_mm256_zeroupper();
 }
+#endif
 
-u32 sunder_align32(u32 current_offset, u32 alignment)
+SUNDER_INTERNAL void sunder_copy_bytes_internal(u8* dst, const u8* src, u64 bytes)
 {
-	return (current_offset + alignment - 1) & ~(alignment - 1);
+	if (dst == src) { return; }
+
+#if defined(SUNDER_X86)
+	// small copies are left to memmove, it already branches on size better than a loop would
+	if (bytes >= 64)
+	{
+		const bool overlapping = dst < src + bytes && src < dst + bytes;
+		const bool non_temporal = !overlapping && bytes > sunder_get_non_temporal_threshold_internal();
+
+		if (sunder_cpu_features.avx2 && bytes >= 256) { sunder_copy_bytes_avx2_internal(dst, src, bytes, non_temporal); }
+		else { sunder_copy_bytes_sse2_internal(dst, src, bytes, non_temporal); }
+
+		return;
+	}
+#endif
+
+	memmove(dst, src, bytes);
 }
 
-u64 sunder_compute_array_size_in_bytes(u64 type_size_in_bytes, u64 element_count)
+// pattern_size divides every vector width, so the pattern at byte i of the range is replicated_pattern[i % 16] and a vector store at i starts at replicated_pattern + i % pattern_size
+SUNDER_INTERNAL void sunder_replicate_fill_pattern_internal(u8* replicated_pattern, u64 replicated_size, const u8* pattern, u32 pattern_size)
 {
-	return type_size_in_bytes * element_count;
+	for (u64 i = 0; i < replicated_size; i++)
+	{
+		replicated_pattern[i] = pattern[i & (pattern_size - 1)];
+	}
 }
 
-bool sunder_is_divisible_by(u64 val, u64 div)
+#if defined(SUNDER_X86)
+SUNDER_INTERNAL void sunder_fill_bytes_sse2_internal(u8* dst, u64 bytes, const u8* replicated_pattern, u32 pattern_size, bool non_temporal)
 {
-	if (div == 0) { return false; }
+	u64 i = sunder_align64((u64)dst, 16) - (u64)dst;
+	const __m128i fill = _mm_loadu_si128((const __m128i*)(replicated_pattern + (i & (pattern_size - 1))));
 
-	return val % div == 0;
+	_mm_storeu_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)replicated_pattern));
+
+	for (; i + 64 <= bytes; i += 64)
+	{
+		if (non_temporal)
+		{
+			_mm_stream_si128((__m128i*)(dst + i), fill);
+			_mm_stream_si128((__m128i*)(dst + i + 16), fill);
+			_mm_stream_si128((__m128i*)(dst + i + 32), fill);
+			_mm_stream_si128((__m128i*)(dst + i + 48), fill);
+		}
+		else
+		{
+			_mm_store_si128((__m128i*)(dst + i), fill);
+			_mm_store_si128((__m128i*)(dst + i + 16), fill);
+			_mm_store_si128((__m128i*)(dst + i + 32), fill);
+			_mm_store_si128((__m128i*)(dst + i + 48), fill);
+		}
+	}
+
+	for (; i + 16 <= bytes; i += 16)
+	{
+		_mm_store_si128((__m128i*)(dst + i), fill);
+	}
+
+	if (non_temporal) { _mm_sfence(); }
+
+	const u64 tail_offset = bytes - 16;
+	_mm_storeu_si128((__m128i*)(dst + tail_offset), _mm_loadu_si128((const __m128i*)(replicated_pattern + (tail_offset & (pattern_size - 1)))));
 }
 
-sunder_arena_suballocation_result_t sunder_suballocate_from_arena_internal(sunder_arena_t* arena, u64 bytes, u32 alignment)
+SUNDER_TARGET_AVX2 SUNDER_INTERNAL void sunder_fill_bytes_avx2_internal(u8* dst, u64 bytes, const u8* replicated_pattern, u32 pattern_size, bool non_temporal)
 {
-	sunder_arena_suballocation_result_t res;
-	const u64 working_alignment = sunder_clamp_u32(SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, alignment);
+	u64 i = sunder_align64((u64)dst, 32) - (u64)dst;
+	const __m256i fill = _mm256_loadu_si256((const __m256i*)(replicated_pattern + (i & (pattern_size - 1))));
 
-	const u64 aligned_offset = sunder_align64(arena->offset, working_alignment);
-	const u64 post_suballocation_offset = aligned_offset + bytes;
+	_mm256_storeu_si256((__m256i*)dst, _mm256_loadu_si256((const __m256i*)replicated_pattern));
 
-	res.result = SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY;
-	if (post_suballocation_offset > arena->capacity) { return res; }
+	for (; i + 128 <= bytes; i += 128)
+	{
+		if (non_temporal)
+		{
+			_mm256_stream_si256((__m256i*)(dst + i), fill);
+			_mm256_stream_si256((__m256i*)(dst + i + 32), fill);
+			_mm256_stream_si256((__m256i*)(dst + i + 64), fill);
+			_mm256_stream_si256((__m256i*)(dst + i + 96), fill);
+		}
+		else
+		{
+			_mm256_store_si256((__m256i*)(dst + i), fill);
+			_mm256_store_si256((__m256i*)(dst + i + 32), fill);
+			_mm256_store_si256((__m256i*)(dst + i + 64), fill);
+			_mm256_store_si256((__m256i*)(dst + i + 96), fill);
+		}
+	}
 
-	void* data = &arena->buffer[aligned_offset];
-	arena->offset = post_suballocation_offset;
+	for (; i + 32 <= bytes; i += 32)
+	{
+		_mm256_store_si256((__m256i*)(dst + i), fill);
+	}
 
-	res.result = SUNDER_ARENA_RESULT_SUCCESS;
-	res.data = data;
-	return res;
+	if (non_temporal) { _mm_sfence(); }
+
+	const u64 tail_offset = bytes - 32;
+	_mm256_storeu_si256((__m256i*)(dst + tail_offset), _mm256_loadu_si256((const __m256i*)(replicated_pattern + (tail_offset & (pattern_size - 1)))));
+
+	_mm256_zeroupper();
 }
+#endif
 
-sunder_arena_suballocation_result_t sunder_suballocate_from_arena_debug_internal(sunder_arena_t* arena, u64 bytes, u32 alignment)
+SUNDER_INTERNAL void sunder_fill_bytes_internal(u8* dst, u64 bytes, const u8* pattern, u32 pattern_size)
 {
-	sunder_arena_suballocation_result_t res;
-	res.data = nullptr;
-	
-	const u32 working_alignment = sunder_clamp_u32(SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, alignment);
+	// 48 bytes so a 32 byte load from any pattern phase stays inside
+	u8 replicated_pattern[48];
+	sunder_replicate_fill_pattern_internal(replicated_pattern, sizeof(replicated_pattern), pattern, pattern_size);
 
-	std::cout << "\n" << arena->offset << "/" << arena->capacity;
-	std::cout << "\nrequested alignment: " << alignment;
-	std::cout << "\nworking alignment: " << working_alignment;
-	std::cout << "\nallocating " << bytes << " bytes";
-	std::cout << "\ncurrent offset: " << arena->offset;
+#if defined(SUNDER_X86)
+	if (bytes >= 64)
+	{
+		const bool non_temporal = bytes > sunder_get_non_temporal_threshold_internal();
 
-	const u64 aligned_offset = sunder_align64(arena->offset, working_alignment);
-	const u64 bytes_of_padding = aligned_offset - arena->offset;
-	const u64 post_suballocation_offset = aligned_offset + bytes;
+		if (sunder_cpu_features.avx2 && bytes >= 256) { sunder_fill_bytes_avx2_internal(dst, bytes, replicated_pattern, pattern_size, non_temporal); }
+		else { sunder_fill_bytes_sse2_internal(dst, bytes, replicated_pattern, pattern_size, non_temporal); }
 
-	res.result = SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY;
+		return;
+	}
+#endif
 
-	if (post_suballocation_offset > arena->capacity)
+	if (pattern_size == 1)
 	{
-		return res;
+		memset(dst, pattern[0], bytes);
+		return;
 	}
 
-	SUNDER_LOG("\ndata assigned offset: ");
-	SUNDER_LOG(aligned_offset);
-	SUNDER_LOG("\nbytes of padding added: ");
-	SUNDER_LOG(bytes_of_padding);
-	SUNDER_LOG("\npost suballocation offset: ");
-	SUNDER_LOG(post_suballocation_offset);
-	SUNDER_LOG("\n");
+	for (u64 i = 0; i < bytes; i++)
+	{
+		dst[i] = replicated_pattern[i & 15u];
+	}
+}
 
-	void* user_block = &arena->buffer[aligned_offset];
+u64 sunder_copy_buffer(void* dst, const void* src, const sunder_buffer_copy_data_t* copying_data)
+{
+	if (dst == nullptr) { return 0; }
+	if (src == nullptr) { return 0; }
 
-	arena->offset = post_suballocation_offset;
+	if (copying_data->bytes_to_write > copying_data->dst_size || copying_data->bytes_to_write > copying_data->src_size || copying_data->bytes_to_write == 0) { return 0; }
 
-	res.result = SUNDER_ARENA_RESULT_SUCCESS;
-	res.data = user_block;
+	sunder_copy_bytes_internal((u8*)dst + copying_data->dst_offset, (const u8*)src + copying_data->src_offset, copying_data->bytes_to_write);
 
-	return res;
+	return copying_data->bytes_to_write;
 }
 
-sunder_arena_result sunder_converge_arena_chain_debug(sunder_arena_t* arena)
+struct sunder_copy_buffer_batch_job_t
 {
-	return SUNDER_ARENA_RESULT_SUCCESS;
+	u8* dst = nullptr;
+	const u8* src = nullptr;
+	const sunder_buffer_copy_data_t* copying_data = nullptr;
+	u64 copy_count = 0;
+};
+
+SUNDER_INTERNAL void sunder_run_copy_buffer_batch_job_internal(void* args)
+{
+	const sunder_copy_buffer_batch_job_t* job = (const sunder_copy_buffer_batch_job_t*)args;
+
+	for (u64 i = 0; i < job->copy_count; i++)
+	{
+		const sunder_buffer_copy_data_t* copy = &job->copying_data[i];
+		sunder_copy_bytes_internal(job->dst + copy->dst_offset, job->src + copy->src_offset, copy->bytes_to_write);
+	}
 }
 
-sunder_arena_result sunder_allocate_arena(sunder_arena_t* arena, u64 capacity, u32 arena_alignment)
+SUNDER_INTERNAL bool sunder_compare_buffer_copy_data_by_dst_offset_internal(const sunder_buffer_copy_data_t* a, const sunder_buffer_copy_data_t* b)
 {
-	if (capacity == 0)
+	return a->dst_offset < b->dst_offset;
+}
+
+u64 sunder_copy_buffer_batch(void* dst, const void* src, const sunder_buffer_copy_data_t* copying_data, u64 copy_count, u32 thread_count)
+{
+	if (dst == nullptr || src == nullptr || copying_data == nullptr || copy_count == 0) { return 0; }
+
+	u64 total_bytes = 0;
+	bool sorted = true;
+
+	for (u64 i = 0; i < copy_count; i++)
 	{
-		return SUNDER_ARENA_RESULT_FAILURE;
+		const sunder_buffer_copy_data_t* copy = &copying_data[i];
+		if (copy->bytes_to_write > copy->dst_size || copy->bytes_to_write > copy->src_size || copy->bytes_to_write == 0) { return 0; }
+
+		total_bytes += copy->bytes_to_write;
+		if (i > 0 && copy->dst_offset < copying_data[i - 1].dst_offset) { sorted = false; }
 	}
 
-	if (arena_alignment < 2 || !sunder_is_power_of_2(arena_alignment))
+	sunder_arena_t* scratch = sunder_get_thread_scratch_arena();
+	const sunder_arena_marker_t marker = scratch != nullptr ? sunder_get_arena_marker(scratch) : sunder_arena_marker_t{};
+	const sunder_arena_suballocation_result_t merged_buffer = scratch != nullptr ? sunder_suballocate_from_arena(scratch, sizeof(sunder_buffer_copy_data_t) * copy_count, alignof(sunder_buffer_copy_data_t)) : sunder_arena_suballocation_result_t{ nullptr, SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED };
+
+	const sunder_buffer_copy_data_t* copies = copying_data;
+	u64 merged_count = copy_count;
+
+	// without scratch memory the descriptors are copied as given, merging is only an optimization
+	if (merged_buffer.result == SUNDER_ARENA_RESULT_SUCCESS)
 	{
-		return SUNDER_ARENA_RESULT_FAILURE;
+		sunder_buffer_copy_data_t* merged = (sunder_buffer_copy_data_t*)merged_buffer.data;
+
+		for (u64 i = 0; i < copy_count; i++)
+		{
+			merged[i] = copying_data[i];
+		}
+
+		if (!sorted) { sunder_quick_sort_buffer_copy_data(merged, 0, (i64)copy_count - 1, sunder_compare_buffer_copy_data_by_dst_offset_internal); }
+
+		merged_count = 1;
+
+		for (u64 i = 1; i < copy_count; i++)
+		{
+			sunder_buffer_copy_data_t* last = &merged[merged_count - 1];
+			const bool touching = merged[i].dst_offset == last->dst_offset + last->bytes_to_write && merged[i].src_offset == last->src_offset + last->bytes_to_write;
+
+			if (touching)
+			{
+				last->bytes_to_write += merged[i].bytes_to_write;
+				continue;
+			}
+
+			merged[merged_count++] = merged[i];
+		}
+
+		copies = merged;
 	}
 
-	arena->buffer = (u8*)sunder_aligned_halloc(capacity, arena_alignment);
+	u32 worker_count = thread_count < SUNDER_COPY_BUFFER_BATCH_MAX_THREAD_COUNT ? thread_count : SUNDER_COPY_BUFFER_BATCH_MAX_THREAD_COUNT;
+	if (worker_count > total_bytes / SUNDER_COPY_BUFFER_BATCH_MIN_BYTES_PER_THREAD) { worker_count = (u32)(total_bytes / SUNDER_COPY_BUFFER_BATCH_MIN_BYTES_PER_THREAD); }
+	if (worker_count > merged_count) { worker_count = (u32)merged_count; }
+	if (worker_count == 0) { worker_count = 1; }
 
-	if (arena->buffer == nullptr)
+	// contiguous runs of descriptors with roughly total_bytes / worker_count bytes each, the calling thread takes the first one
+	sunder_copy_buffer_batch_job_t jobs[SUNDER_COPY_BUFFER_BATCH_MAX_THREAD_COUNT];
+	u32 job_count = 0;
+	u64 run_begin = 0;
+	u64 run_bytes = 0;
+
+	for (u64 i = 0; i < merged_count; i++)
 	{
-		return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE; 
+		run_bytes += copies[i].bytes_to_write;
+
+		if (i + 1 == merged_count || (job_count + 1 < worker_count && run_bytes * worker_count >= total_bytes))
+		{
+			jobs[job_count].dst = (u8*)dst;
+			jobs[job_count].src = (const u8*)src;
+			jobs[job_count].copying_data = copies + run_begin;
+			jobs[job_count].copy_count = i + 1 - run_begin;
+			job_count++;
+
+			run_begin = i + 1;
+			run_bytes = 0;
+		}
 	}
 
-	arena->capacity = capacity;
-	arena->offset = 0;
+	sunder_thread_t workers[SUNDER_COPY_BUFFER_BATCH_MAX_THREAD_COUNT];
+
+	for (u32 i = 1; i < job_count; i++)
+	{
+		sunder_launch_thread(&workers[i], sunder_run_copy_buffer_batch_job_internal, &jobs[i]);
+	}
 
-	sunder_initialize_buffer(arena->buffer, arena->capacity, 0, arena->capacity);
+	sunder_run_copy_buffer_batch_job_internal(&jobs[0]);
 
-	return SUNDER_ARENA_RESULT_SUCCESS;
+	for (u32 i = 1; i < job_count; i++)
+	{
+		sunder_join_thread(&workers[i]);
+	}
+
+	if (scratch != nullptr) { sunder_rollback_arena_to_marker(scratch, &marker); }
+
+	return total_bytes;
 }
 
-sunder_arena_suballocation_result_t sunder_suballocate_from_arena(sunder_arena_t* arena, u64 bytes, u32 alignment)
+bool sunder_is_even(u64 val)
+{
+	return val % 2 == 0;
+}
+
+bool sunder_is_power_of_2(u64 val)
+{
+	return val != 0 && (val & (val - 1)) == 0;
+}
+
+u64 sunder_align64(u64 current_offset, u64 alignment)
+{
+	return (current_offset + alignment - 1) & ~(alignment - 1);
+}
+
+u32 sunder_align32(u32 current_offset, u32 alignment)
+{
+	return (current_offset + alignment - 1) & ~(alignment - 1);
+}
+
+u64 sunder_compute_array_size_in_bytes(u64 type_size_in_bytes, u64 element_count)
+{
+	return type_size_in_bytes * element_count;
+}
+
+u64 sunder_get_os_page_size()
+{
+#if defined(_WIN32)
+	SYSTEM_INFO system_info;
+	GetSystemInfo(&system_info);
+
+	return system_info.dwPageSize;
+#else
+	SUNDER_PERSISTENT const u64 page_size = (u64)sysconf(_SC_PAGESIZE);
+
+	return page_size;
+#endif
+}
+
+bool sunder_is_divisible_by(u64 val, u64 div)
+{
+	if (div == 0) { return false; }
+
+	return val % div == 0;
+}
+
+// splitmix64 of the offset, offsets of free blocks are unique so no two nodes of one arena get the same priority by construction
+SUNDER_INTERNAL u64 sunder_get_free_block_priority_internal(u64 offset)
+{
+	u64 val = offset + 0x9e3779b97f4a7c15ull;
+	val = (val ^ (val >> 30)) * 0xbf58476d1ce4e5b9ull;
+	val = (val ^ (val >> 27)) * 0x94d049bb133111ebull;
+	return val ^ (val >> 31);
+}
+
+SUNDER_INTERNAL u32* sunder_get_free_block_children_internal(sunder_arena_free_block_node_t* node, bool by_size)
+{
+	return by_size ? node->size_children : node->offset_children;
+}
+
+SUNDER_INTERNAL bool sunder_is_free_block_ordered_before_internal(const sunder_arena_free_memory_block_t& block, const sunder_arena_free_memory_block_t& key, bool by_size)
+{
+	if (!by_size) { return block.suballocation_starting_offset < key.suballocation_starting_offset; }
+
+	return block.suballocation_size < key.suballocation_size || (block.suballocation_size == key.suballocation_size && block.suballocation_starting_offset < key.suballocation_starting_offset);
+}
+
+SUNDER_INTERNAL void sunder_update_free_block_node_internal(sunder_arena_free_block_node_t* nodes, u32 index)
+{
+	sunder_arena_free_block_node_t* node = &nodes[index];
+	node->largest_size = node->block.suballocation_size;
+
+	for (u32 side = 0; side < 2; side++)
+	{
+		const u32 child = node->offset_children[side];
+		if (child != SUNDER_ARENA_FREE_BLOCK_NONE && nodes[child].largest_size > node->largest_size) { node->largest_size = nodes[child].largest_size; }
+	}
+}
+
+// left receives every node ordered before key, right the rest
+SUNDER_INTERNAL void sunder_split_free_blocks_internal(sunder_arena_free_block_node_t* nodes, u32 root, const sunder_arena_free_memory_block_t& key, bool by_size, u32* left, u32* right)
+{
+	if (root == SUNDER_ARENA_FREE_BLOCK_NONE)
+	{
+		*left = SUNDER_ARENA_FREE_BLOCK_NONE;
+		*right = SUNDER_ARENA_FREE_BLOCK_NONE;
+		return;
+	}
+
+	u32* children = sunder_get_free_block_children_internal(&nodes[root], by_size);
+
+	if (sunder_is_free_block_ordered_before_internal(nodes[root].block, key, by_size))
+	{
+		sunder_split_free_blocks_internal(nodes, children[1], key, by_size, &children[1], right);
+		*left = root;
+	}
+
+	else
+	{
+		sunder_split_free_blocks_internal(nodes, children[0], key, by_size, left, &children[0]);
+		*right = root;
+	}
+
+	if (!by_size) { sunder_update_free_block_node_internal(nodes, root); }
+}
+
+// every node of left has to be ordered before every node of right
+SUNDER_INTERNAL u32 sunder_merge_free_blocks_internal(sunder_arena_free_block_node_t* nodes, u32 left, u32 right, bool by_size)
+{
+	if (left == SUNDER_ARENA_FREE_BLOCK_NONE) { return right; }
+	if (right == SUNDER_ARENA_FREE_BLOCK_NONE) { return left; }
+
+	if (nodes[left].priority > nodes[right].priority)
+	{
+		u32* children = sunder_get_free_block_children_internal(&nodes[left], by_size);
+		children[1] = sunder_merge_free_blocks_internal(nodes, children[1], right, by_size);
+		if (!by_size) { sunder_update_free_block_node_internal(nodes, left); }
+
+		return left;
+	}
+
+	u32* children = sunder_get_free_block_children_internal(&nodes[right], by_size);
+	children[0] = sunder_merge_free_blocks_internal(nodes, left, children[0], by_size);
+	if (!by_size) { sunder_update_free_block_node_internal(nodes, right); }
+
+	return right;
+}
+
+SUNDER_INTERNAL void sunder_clear_free_blocks_internal(sunder_arena_t* arena)
+{
+	arena->free_block_offset_root = SUNDER_ARENA_FREE_BLOCK_NONE;
+	arena->free_block_size_root = SUNDER_ARENA_FREE_BLOCK_NONE;
+	arena->free_block_unused_node = SUNDER_ARENA_FREE_BLOCK_NONE;
+	arena->free_block_count = 0;
+
+	for (u32 i = arena->free_block_capacity; i > 0; i--)
+	{
+		arena->free_block_nodes[i - 1].offset_children[0] = arena->free_block_unused_node;
+		arena->free_block_unused_node = i - 1;
+	}
+}
+
+// every unused node is linked into the unused list, so capacity - count nodes can always be taken without growing
+SUNDER_INTERNAL sunder_arena_result sunder_reserve_free_block_nodes_internal(sunder_arena_t* arena, u32 additional_count)
+{
+	if (arena->free_block_count + additional_count <= arena->free_block_capacity) { return SUNDER_ARENA_RESULT_SUCCESS; }
+
+	u32 new_capacity = arena->free_block_capacity > 0 ? arena->free_block_capacity * 2 : SUNDER_DEFAULT_ARENA_FREE_BUFFER_ELEMENT_COUNT;
+	if (new_capacity < arena->free_block_count + additional_count) { new_capacity = arena->free_block_count + additional_count; }
+
+	sunder_arena_free_block_node_t* new_nodes = (sunder_arena_free_block_node_t*)sunder_halloc(sizeof(sunder_arena_free_block_node_t), new_capacity);
+	if (new_nodes == nullptr) { return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE; }
+
+	if (arena->free_block_capacity > 0) { sunder_copy_bytes_internal((u8*)new_nodes, (const u8*)arena->free_block_nodes, sizeof(sunder_arena_free_block_node_t) * arena->free_block_capacity); }
+
+	for (u32 i = new_capacity; i > arena->free_block_capacity; i--)
+	{
+		new_nodes[i - 1].offset_children[0] = arena->free_block_unused_node;
+		arena->free_block_unused_node = i - 1;
+	}
+
+	sunder_free((void**)&arena->free_block_nodes);
+
+	arena->free_block_nodes = new_nodes;
+	arena->free_block_capacity = new_capacity;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL sunder_arena_result sunder_insert_free_block_internal(sunder_arena_t* arena, const sunder_arena_free_memory_block_t& block)
+{
+	const sunder_arena_result reserve_result = sunder_reserve_free_block_nodes_internal(arena, 1);
+	if (reserve_result != SUNDER_ARENA_RESULT_SUCCESS) { return reserve_result; }
+
+	sunder_arena_free_block_node_t* nodes = arena->free_block_nodes;
+	const u32 index = arena->free_block_unused_node;
+	arena->free_block_unused_node = nodes[index].offset_children[0];
+
+	nodes[index] = sunder_arena_free_block_node_t{};
+	nodes[index].block = block;
+	nodes[index].largest_size = block.suballocation_size;
+	nodes[index].priority = sunder_get_free_block_priority_internal(block.suballocation_starting_offset);
+
+	for (u32 tree = 0; tree < 2; tree++)
+	{
+		const bool by_size = tree == 1;
+		u32* root = by_size ? &arena->free_block_size_root : &arena->free_block_offset_root;
+		u32 left = SUNDER_ARENA_FREE_BLOCK_NONE;
+		u32 right = SUNDER_ARENA_FREE_BLOCK_NONE;
+
+		sunder_split_free_blocks_internal(nodes, *root, block, by_size, &left, &right);
+		*root = sunder_merge_free_blocks_internal(nodes, sunder_merge_free_blocks_internal(nodes, left, index, by_size), right, by_size);
+	}
+
+	arena->free_block_count++;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL void sunder_remove_free_block_internal(sunder_arena_t* arena, u32 index)
+{
+	sunder_arena_free_block_node_t* nodes = arena->free_block_nodes;
+	const sunder_arena_free_memory_block_t block = nodes[index].block;
+
+	sunder_arena_free_memory_block_t past_block = block;
+	past_block.suballocation_starting_offset++;
+
+	for (u32 tree = 0; tree < 2; tree++)
+	{
+		const bool by_size = tree == 1;
+		u32* root = by_size ? &arena->free_block_size_root : &arena->free_block_offset_root;
+		u32 left = SUNDER_ARENA_FREE_BLOCK_NONE;
+		u32 middle = SUNDER_ARENA_FREE_BLOCK_NONE;
+		u32 right = SUNDER_ARENA_FREE_BLOCK_NONE;
+
+		sunder_split_free_blocks_internal(nodes, *root, block, by_size, &left, &right);
+		sunder_split_free_blocks_internal(nodes, right, past_block, by_size, &middle, &right);
+		*root = sunder_merge_free_blocks_internal(nodes, left, right, by_size);
+	}
+
+	nodes[index].offset_children[0] = arena->free_block_unused_node;
+	arena->free_block_unused_node = index;
+	arena->free_block_count--;
+}
+
+// first free block starting at or after offset
+SUNDER_INTERNAL u32 sunder_find_free_block_at_or_after_internal(const sunder_arena_t* arena, u64 offset)
+{
+	u32 found = SUNDER_ARENA_FREE_BLOCK_NONE;
+
+	for (u32 node = arena->free_block_offset_root; node != SUNDER_ARENA_FREE_BLOCK_NONE;)
+	{
+		if (arena->free_block_nodes[node].block.suballocation_starting_offset >= offset)
+		{
+			found = node;
+			node = arena->free_block_nodes[node].offset_children[0];
+		}
+
+		else { node = arena->free_block_nodes[node].offset_children[1]; }
+	}
+
+	return found;
+}
+
+// last free block starting at or before offset
+SUNDER_INTERNAL u32 sunder_find_free_block_at_or_before_internal(const sunder_arena_t* arena, u64 offset)
+{
+	u32 found = SUNDER_ARENA_FREE_BLOCK_NONE;
+
+	for (u32 node = arena->free_block_offset_root; node != SUNDER_ARENA_FREE_BLOCK_NONE;)
+	{
+		if (arena->free_block_nodes[node].block.suballocation_starting_offset <= offset)
+		{
+			found = node;
+			node = arena->free_block_nodes[node].offset_children[1];
+		}
+
+		else { node = arena->free_block_nodes[node].offset_children[0]; }
+	}
+
+	return found;
+}
+
+SUNDER_INTERNAL bool sunder_does_free_block_fit_internal(const sunder_arena_free_memory_block_t& block, u64 bytes, u64 working_alignment)
+{
+	return sunder_align64(block.suballocation_starting_offset, working_alignment) + bytes <= block.suballocation_starting_offset + block.suballocation_size;
+}
+
+// lowest offset block that fits, subtrees whose largest block is too small are skipped as a whole
+SUNDER_INTERNAL u32 sunder_find_first_fit_free_block_internal(const sunder_arena_free_block_node_t* nodes, u32 node, u64 bytes, u64 working_alignment)
+{
+	if (node == SUNDER_ARENA_FREE_BLOCK_NONE || nodes[node].largest_size < bytes) { return SUNDER_ARENA_FREE_BLOCK_NONE; }
+
+	const u32 left = sunder_find_first_fit_free_block_internal(nodes, nodes[node].offset_children[0], bytes, working_alignment);
+	if (left != SUNDER_ARENA_FREE_BLOCK_NONE) { return left; }
+
+	if (sunder_does_free_block_fit_internal(nodes[node].block, bytes, working_alignment)) { return node; }
+
+	return sunder_find_first_fit_free_block_internal(nodes, nodes[node].offset_children[1], bytes, working_alignment);
+}
+
+// smallest block that fits, the walk only leaves the lower bound path when alignment makes a large enough block unusable
+SUNDER_INTERNAL u32 sunder_find_best_fit_free_block_internal(const sunder_arena_free_block_node_t* nodes, u32 node, u64 bytes, u64 working_alignment)
+{
+	if (node == SUNDER_ARENA_FREE_BLOCK_NONE) { return SUNDER_ARENA_FREE_BLOCK_NONE; }
+
+	if (nodes[node].block.suballocation_size < bytes) { return sunder_find_best_fit_free_block_internal(nodes, nodes[node].size_children[1], bytes, working_alignment); }
+
+	const u32 left = sunder_find_best_fit_free_block_internal(nodes, nodes[node].size_children[0], bytes, working_alignment);
+	if (left != SUNDER_ARENA_FREE_BLOCK_NONE) { return left; }
+
+	if (sunder_does_free_block_fit_internal(nodes[node].block, bytes, working_alignment)) { return node; }
+
+	return sunder_find_best_fit_free_block_internal(nodes, nodes[node].size_children[1], bytes, working_alignment);
+}
+
+// coalesces with neighbouring free blocks, gives the result back to the bump region when it ends at the arena offset
+SUNDER_INTERNAL sunder_arena_result sunder_release_free_block_internal(sunder_arena_t* arena, sunder_arena_free_memory_block_t block)
+{
+	// reserving up front means nothing has been unlinked yet when growing the node pool fails
+	const sunder_arena_result reserve_result = sunder_reserve_free_block_nodes_internal(arena, 1);
+	if (reserve_result != SUNDER_ARENA_RESULT_SUCCESS) { return reserve_result; }
+
+	const u32 next = sunder_find_free_block_at_or_after_internal(arena, block.suballocation_starting_offset);
+
+	if (next != SUNDER_ARENA_FREE_BLOCK_NONE && arena->free_block_nodes[next].block.suballocation_starting_offset == block.suballocation_starting_offset + block.suballocation_size)
+	{
+		block.suballocation_size += arena->free_block_nodes[next].block.suballocation_size;
+		sunder_remove_free_block_internal(arena, next);
+	}
+
+	const u32 previous = block.suballocation_starting_offset > 0 ? sunder_find_free_block_at_or_before_internal(arena, block.suballocation_starting_offset - 1) : SUNDER_ARENA_FREE_BLOCK_NONE;
+
+	if (previous != SUNDER_ARENA_FREE_BLOCK_NONE)
+	{
+		const sunder_arena_free_memory_block_t previous_block = arena->free_block_nodes[previous].block;
+
+		if (previous_block.suballocation_starting_offset + previous_block.suballocation_size == block.suballocation_starting_offset)
+		{
+			block.suballocation_starting_offset = previous_block.suballocation_starting_offset;
+			block.suballocation_size += previous_block.suballocation_size;
+			sunder_remove_free_block_internal(arena, previous);
+		}
+	}
+
+	// the offset never drops below an outstanding marker, the rollback would otherwise hand out memory nothing owns
+	if (block.suballocation_starting_offset + block.suballocation_size == arena->offset && arena->marker_depth == 0)
+	{
+		arena->offset = block.suballocation_starting_offset;
+		return SUNDER_ARENA_RESULT_SUCCESS;
+	}
+
+	return sunder_insert_free_block_internal(arena, block);
+}
+
+// removes the block at index and puts back whatever is left of it around [offset, offset + bytes), the caller reserves the node for the second leftover
+SUNDER_INTERNAL void sunder_carve_free_block_internal(sunder_arena_t* arena, u32 index, u64 offset, u64 bytes)
+{
+	const sunder_arena_free_memory_block_t block = arena->free_block_nodes[index].block;
+	const u64 block_end = block.suballocation_starting_offset + block.suballocation_size;
+
+	sunder_remove_free_block_internal(arena, index);
+
+	if (offset > block.suballocation_starting_offset)
+	{
+		sunder_arena_free_memory_block_t leading_block;
+		leading_block.suballocation_starting_offset = block.suballocation_starting_offset;
+		leading_block.suballocation_size = offset - block.suballocation_starting_offset;
+		sunder_insert_free_block_internal(arena, leading_block);
+	}
+
+	if (offset + bytes < block_end)
+	{
+		sunder_arena_free_memory_block_t trailing_block;
+		trailing_block.suballocation_starting_offset = offset + bytes;
+		trailing_block.suballocation_size = block_end - trailing_block.suballocation_starting_offset;
+		sunder_insert_free_block_internal(arena, trailing_block);
+	}
+}
+
+// SUCCESS writes the aligned offset of the carved out region, FAILURE means no free block fits, anything else is an error to hand to the caller
+SUNDER_INTERNAL sunder_arena_result sunder_suballocate_from_free_blocks_internal(sunder_arena_t* arena, u64 bytes, u64 working_alignment, u64* aligned_offset)
+{
+	const bool first_suitable = SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_SUBALLOCATION_ALGORITHM_FIRST_SUITABLE_BIT, 1u);
+	const u32 index = first_suitable ? sunder_find_first_fit_free_block_internal(arena->free_block_nodes, arena->free_block_offset_root, bytes, working_alignment) : sunder_find_best_fit_free_block_internal(arena->free_block_nodes, arena->free_block_size_root, bytes, working_alignment);
+
+	if (index == SUNDER_ARENA_FREE_BLOCK_NONE) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	// one node is given back by removing the block, splitting it can take two
+	const sunder_arena_result reserve_result = sunder_reserve_free_block_nodes_internal(arena, 1);
+	if (reserve_result != SUNDER_ARENA_RESULT_SUCCESS) { return reserve_result; }
+
+	*aligned_offset = sunder_align64(arena->free_block_nodes[index].block.suballocation_starting_offset, working_alignment);
+	sunder_carve_free_block_internal(arena, index, *aligned_offset, bytes);
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL sunder_arena_result sunder_claim_free_range_internal(sunder_arena_t* arena, u64 offset, u64 bytes)
+{
+	const sunder_arena_result reserve_result = sunder_reserve_free_block_nodes_internal(arena, 1);
+	if (reserve_result != SUNDER_ARENA_RESULT_SUCCESS) { return reserve_result; }
+
+	// the range may start in bump territory when releasing handed the tail of the arena back to the offset
+	if (offset >= arena->offset)
+	{
+		if (offset > arena->offset)
+		{
+			sunder_arena_free_memory_block_t leading_block;
+			leading_block.suballocation_starting_offset = arena->offset;
+			leading_block.suballocation_size = offset - arena->offset;
+			sunder_insert_free_block_internal(arena, leading_block);
+		}
+
+		arena->offset = offset + bytes;
+		return SUNDER_ARENA_RESULT_SUCCESS;
+	}
+
+	const u32 index = sunder_find_free_block_at_or_before_internal(arena, offset);
+	if (index == SUNDER_ARENA_FREE_BLOCK_NONE) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const sunder_arena_free_memory_block_t block = arena->free_block_nodes[index].block;
+	if (offset + bytes > block.suballocation_starting_offset + block.suballocation_size) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	sunder_carve_free_block_internal(arena, index, offset, bytes);
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL u32 sunder_lower_bound_live_entry_internal(const sunder_handle_arena_t* handle_arena, u64 offset)
+{
+	u32 low = 0;
+	u32 high = handle_arena->live_count;
+
+	while (low < high)
+	{
+		const u32 mid = low + (high - low) / 2;
+
+		if (handle_arena->entries[handle_arena->live_entries[mid]].offset < offset) { low = mid + 1; }
+		else { high = mid; }
+	}
+
+	return low;
+}
+
+SUNDER_INTERNAL u64 sunder_atomic_load_u64_internal(const volatile u64* value)
+{
+#if defined(_MSC_VER)
+	// aligned 64 bit loads are atomic on every target msvc supports, volatile keeps acquire semantics
+	return *value;
+#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// on failure expected is updated with the current value
+SUNDER_INTERNAL bool sunder_atomic_compare_exchange_u64_internal(volatile u64* value, u64* expected, u64 desired)
+{
+#if defined(_MSC_VER)
+	const u64 previous = (u64)_InterlockedCompareExchange64((volatile long long*)value, (long long)desired, (long long)*expected);
+	if (previous == *expected) { return true; }
+
+	*expected = previous;
+	return false;
+#else
+	return __atomic_compare_exchange_n(value, expected, desired, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+SUNDER_INTERNAL u64 sunder_atomic_add_u64_internal(volatile u64* value, u64 addend)
+{
+#if defined(_MSC_VER)
+	return (u64)_InterlockedExchangeAdd64((volatile long long*)value, (long long)addend);
+#else
+	return __atomic_fetch_add(value, addend, __ATOMIC_RELAXED);
+#endif
+}
+
+SUNDER_INTERNAL void sunder_atomic_max_u64_internal(volatile u64* value, u64 candidate)
+{
+	u64 current = sunder_atomic_load_u64_internal(value);
+	while (current < candidate && !sunder_atomic_compare_exchange_u64_internal(value, &current, candidate)) {}
+}
+
+#if defined(SUNDER_ALLOCATION_TRACKING)
+SUNDER_INTERNAL void sunder_atomic_store_u64_internal(volatile u64* value, u64 desired)
+{
+#if defined(_MSC_VER)
+	*value = desired;
+#else
+	__atomic_store_n(value, desired, __ATOMIC_RELEASE);
+#endif
+}
+
+// counters are only ever written by the owning thread (load + store, no read modify write), snapshots read them concurrently
+struct sunder_allocation_tag_thread_table_t
+{
+	u64 allocation_counts[SUNDER_ALLOCATION_TAG_COUNT]{};
+	u64 free_counts[SUNDER_ALLOCATION_TAG_COUNT]{};
+	u64 size_histograms[SUNDER_ALLOCATION_TAG_COUNT][SUNDER_ALLOCATION_TAG_HISTOGRAM_BUCKET_COUNT]{};
+	sunder_allocation_tag_thread_table_t* next = nullptr;
+	sunder_allocation_tag_thread_table_t* previous = nullptr;
+	bool registered = false;
+
+	~sunder_allocation_tag_thread_table_t();
+};
+
+// header in front of tagged halloc / aligned_halloc blocks, prefix_size is the distance to the start of the underlying block
+struct sunder_allocation_tag_header_t
+{
+	u64 bytes = 0;
+	u32 tag = 0;
+	u32 prefix_size = 0;
+};
+
+SUNDER_INTERNAL sunder_mutex_t sunder_allocation_tag_registry_mutex;
+SUNDER_INTERNAL sunder_allocation_tag_thread_table_t* sunder_allocation_tag_thread_tables = nullptr;
+SUNDER_INTERNAL sunder_allocation_tag_thread_table_t sunder_allocation_tag_retired_table;
+SUNDER_INTERNAL u64 sunder_allocation_tag_live_bytes[SUNDER_ALLOCATION_TAG_COUNT]{};
+SUNDER_INTERNAL u64 sunder_allocation_tag_peak_bytes[SUNDER_ALLOCATION_TAG_COUNT]{};
+SUNDER_INTERNAL thread_local sunder_allocation_tag_thread_table_t sunder_allocation_tag_thread_table;
+
+sunder_allocation_tag_thread_table_t::~sunder_allocation_tag_thread_table_t()
+{
+	if (!registered) { return; }
+
+	// exiting threads fold their counts into the retired table so snapshots never lose them
+	std::lock_guard<std::mutex> lock(sunder_allocation_tag_registry_mutex.mutex);
+
+	for (u32 tag = 0; tag < SUNDER_ALLOCATION_TAG_COUNT; tag++)
+	{
+		sunder_allocation_tag_retired_table.allocation_counts[tag] += allocation_counts[tag];
+		sunder_allocation_tag_retired_table.free_counts[tag] += free_counts[tag];
+
+		for (u32 bucket = 0; bucket < SUNDER_ALLOCATION_TAG_HISTOGRAM_BUCKET_COUNT; bucket++)
+		{
+			sunder_allocation_tag_retired_table.size_histograms[tag][bucket] += size_histograms[tag][bucket];
+		}
+	}
+
+	if (previous != nullptr) { previous->next = next; }
+	else { sunder_allocation_tag_thread_tables = next; }
+	if (next != nullptr) { next->previous = previous; }
+
+	registered = false;
+}
+
+SUNDER_INTERNAL sunder_allocation_tag_thread_table_t* sunder_get_allocation_tag_thread_table_internal()
+{
+	sunder_allocation_tag_thread_table_t* table = &sunder_allocation_tag_thread_table;
+	if (table->registered) { return table; }
+
+	std::lock_guard<std::mutex> lock(sunder_allocation_tag_registry_mutex.mutex);
+
+	table->previous = nullptr;
+	table->next = sunder_allocation_tag_thread_tables;
+	if (sunder_allocation_tag_thread_tables != nullptr) { sunder_allocation_tag_thread_tables->previous = table; }
+	sunder_allocation_tag_thread_tables = table;
+	table->registered = true;
+
+	return table;
+}
+
+SUNDER_INTERNAL u32 sunder_get_allocation_tag_internal(u32 tag)
+{
+	return tag < SUNDER_ALLOCATION_TAG_COUNT ? tag : SUNDER_ALLOCATION_TAG_COUNT - 1;
+}
+
+SUNDER_INTERNAL void sunder_track_allocation_internal(u32 tag, u64 bytes, u64 live_bytes)
+{
+	sunder_allocation_tag_thread_table_t* table = sunder_get_allocation_tag_thread_table_internal();
+
+	u32 bucket = 0;
+	while (bucket + 1 < SUNDER_ALLOCATION_TAG_HISTOGRAM_BUCKET_COUNT && (bytes >> (bucket + 1)) != 0) { bucket++; }
+
+	sunder_atomic_store_u64_internal(&table->allocation_counts[tag], table->allocation_counts[tag] + 1);
+	sunder_atomic_store_u64_internal(&table->size_histograms[tag][bucket], table->size_histograms[tag][bucket] + 1);
+
+	if (live_bytes == 0) { return; }
+
+	const u64 live = sunder_atomic_add_u64_internal(&sunder_allocation_tag_live_bytes[tag], live_bytes) + live_bytes;
+	sunder_atomic_max_u64_internal(&sunder_allocation_tag_peak_bytes[tag], live);
+}
+
+SUNDER_INTERNAL void sunder_track_free_internal(u32 tag, u64 live_bytes)
+{
+	sunder_allocation_tag_thread_table_t* table = sunder_get_allocation_tag_thread_table_internal();
+
+	sunder_atomic_store_u64_internal(&table->free_counts[tag], table->free_counts[tag] + 1);
+	sunder_atomic_add_u64_internal(&sunder_allocation_tag_live_bytes[tag], (u64)0 - live_bytes);
+}
+#endif
+
+SUNDER_INTERNAL u32 sunder_log2_u64_internal(u64 val)
+{
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanReverse64(&index, val);
+	return (u32)index;
+#else
+	return 63u - (u32)__builtin_clzll(val);
+#endif
+}
+
+SUNDER_INTERNAL u8 sunder_merge_buddy_nodes_internal(u8 left, u8 right, u32 order)
+{
+	// both halves entirely free, the parent becomes a single free block again
+	if (left == order && right == order) { return (u8)(order + 1); }
+
+	return left > right ? left : right;
+}
+
+SUNDER_INTERNAL void sunder_update_buddy_ancestors_internal(sunder_buddy_allocator_t* buddy, u64 node, u32 order)
+{
+	while (node != 0)
+	{
+		node = (node - 1) / 2;
+		order++;
+
+		buddy->tree[node] = sunder_merge_buddy_nodes_internal(buddy->tree[node * 2 + 1], buddy->tree[node * 2 + 2], order);
+	}
+}
+
+// reserves address space only, nothing is backed by memory until committed
+SUNDER_INTERNAL u8* sunder_reserve_virtual_memory_internal(u64 bytes, u64 alignment)
+{
+#if defined(_WIN32)
+	// reservations are aligned to the allocation granularity (64 KB)
+	if (alignment > 65536u) { return nullptr; }
+
+	return (u8*)VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+#else
+	const u64 page_size = sunder_get_os_page_size();
+	const u64 reservation_size = alignment > page_size ? bytes + alignment : bytes;
+
+	void* reservation = mmap(nullptr, reservation_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (reservation == MAP_FAILED) { return nullptr; }
+	if (reservation_size == bytes) { return (u8*)reservation; }
+
+	// over reserved to honor an alignment above the page size, trim both ends
+	u8* reservation_begin = (u8*)reservation;
+	u8* aligned_begin = (u8*)sunder_align64((u64)reservation_begin, alignment);
+	const u64 head_size = (u64)(aligned_begin - reservation_begin);
+	const u64 tail_size = reservation_size - head_size - bytes;
+
+	if (head_size > 0) { munmap(reservation_begin, head_size); }
+	if (tail_size > 0) { munmap(aligned_begin + bytes, tail_size); }
+
+	return aligned_begin;
+#endif
+}
+
+SUNDER_INTERNAL bool sunder_commit_virtual_memory_internal(u8* address, u64 bytes)
+{
+#if defined(_WIN32)
+	return VirtualAlloc(address, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+	return mprotect(address, bytes, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+SUNDER_INTERNAL void sunder_release_virtual_memory_internal(u8* address, u64 bytes)
+{
+#if defined(_WIN32)
+	VirtualFree(address, 0, MEM_RELEASE);
+#else
+	munmap(address, bytes);
+#endif
+}
+
+SUNDER_INTERNAL u8* sunder_map_huge_pages_internal(u64 bytes)
+{
+#if defined(_WIN32)
+	return (u8*)VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+#elif defined(MAP_HUGETLB)
+	i32 map_flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_HUGE_2MB)
+	map_flags |= MAP_HUGE_2MB;
+#endif
+	void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, map_flags, -1, 0);
+
+	return mapping == MAP_FAILED ? nullptr : (u8*)mapping;
+#else
+	return nullptr;
+#endif
+}
+
+SUNDER_INTERNAL bool sunder_advise_huge_pages_internal(u8* address, u64 bytes)
+{
+#if defined(MADV_HUGEPAGE)
+	return madvise(address, bytes, MADV_HUGEPAGE) == 0;
+#else
+	return false;
+#endif
+}
+
+// shared by sunder_allocate_arena and the snapshots, so every arena that can be saved can be loaded again
+SUNDER_INTERNAL bool sunder_is_valid_arena_alignment_internal(u32 arena_alignment)
+{
+	return arena_alignment >= 2 && sunder_is_power_of_2(arena_alignment);
+}
+
+SUNDER_INTERNAL bool sunder_is_arena_memory_mapped_internal(u32 flags)
+{
+	return (SUNDER_IS_ANY_BIT_SET(flags, SUNDER_ARENA_BITS_VIRTUAL_MEMORY_BACKEND_BIT, 1u)) || (SUNDER_IS_ANY_BIT_SET(flags, SUNDER_ARENA_BITS_HUGE_PAGES_BIT, 1u));
+}
+
+SUNDER_INTERNAL u64 sunder_compute_snapshot_checksum_internal(const u8* data, u64 bytes)
+{
+	// fnv-1a over 8 byte words, the byte at a time variant is too slow for arenas in the gigabytes
+	u64 hash = 0xcbf29ce484222325ull;
+	u64 i = 0;
+
+	for (; i + 8 <= bytes; i += 8)
+	{
+		u64 word = 0;
+		memcpy(&word, data + i, 8);
+		hash = (hash ^ word) * 0x100000001b3ull;
+	}
+
+	for (; i < bytes; i++)
+	{
+		hash = (hash ^ data[i]) * 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+struct sunder_arena_block_t
+{
+	u8* buffer = nullptr;
+	u64 capacity = 0;
+	u64 committed = 0;
+	u64 page_size = 0;
+	sunder_arena_result result = SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE;
+};
+
+// allocates a block through the backend selected by flags, capacity is rounded up to what the backend actually hands out
+SUNDER_INTERNAL sunder_arena_block_t sunder_allocate_arena_block_internal(u32 flags, u32 alignment, u64 capacity)
+{
+	sunder_arena_block_t block;
+	const bool commit_lazily = SUNDER_IS_ANY_BIT_SET(flags, SUNDER_ARENA_BITS_VIRTUAL_MEMORY_BACKEND_BIT, 1u);
+
+	if (SUNDER_IS_ANY_BIT_SET(flags, SUNDER_ARENA_BITS_HUGE_PAGES_BIT, 1u))
+	{
+#if defined(_WIN32)
+		const u64 huge_page_size = GetLargePageMinimum() > 0 ? GetLargePageMinimum() : SUNDER_ARENA_HUGE_PAGE_SIZE;
+#else
+		const u64 huge_page_size = SUNDER_ARENA_HUGE_PAGE_SIZE;
+#endif
+		block.capacity = sunder_align64(capacity, huge_page_size);
+		block.buffer = sunder_map_huge_pages_internal(block.capacity);
+
+		if (block.buffer != nullptr)
+		{
+			// explicit huge pages are reserved as a whole by the os, there is nothing left to commit
+			block.committed = block.capacity;
+			block.page_size = huge_page_size;
+			block.result = SUNDER_ARENA_RESULT_SUCCESS;
+			return block;
+		}
+
+#if defined(_WIN32)
+		// no transparent huge pages to fall back to, a regular reservation will do
+		const u64 fallback_alignment = alignment;
+#else
+		const u64 fallback_alignment = alignment > huge_page_size ? alignment : huge_page_size;
+#endif
+		block.buffer = sunder_reserve_virtual_memory_internal(block.capacity, fallback_alignment);
+		if (block.buffer == nullptr) { return block; }
+
+		const bool transparent = sunder_advise_huge_pages_internal(block.buffer, block.capacity);
+		block.page_size = transparent ? huge_page_size : sunder_get_os_page_size();
+		block.result = transparent ? SUNDER_ARENA_RESULT_SUCCESS_HUGE_PAGES_ARE_TRANSPARENT : SUNDER_ARENA_RESULT_SUCCESS_HUGE_PAGES_UNAVAILABLE;
+
+		if (!commit_lazily)
+		{
+			if (!sunder_commit_virtual_memory_internal(block.buffer, block.capacity))
+			{
+				sunder_release_virtual_memory_internal(block.buffer, block.capacity);
+				block.buffer = nullptr;
+				block.result = SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE;
+				return block;
+			}
+
+			block.committed = block.capacity;
+		}
+
+		return block;
+	}
+
+	block.page_size = sunder_get_os_page_size();
+
+	if (commit_lazily)
+	{
+		block.capacity = sunder_align64(capacity, block.page_size);
+		block.buffer = sunder_reserve_virtual_memory_internal(block.capacity, alignment);
+		if (block.buffer != nullptr) { block.result = SUNDER_ARENA_RESULT_SUCCESS; }
+
+		return block;
+	}
+
+	block.capacity = capacity;
+	block.committed = capacity;
+	block.buffer = (u8*)sunder_aligned_halloc(capacity, alignment);
+
+	if (block.buffer != nullptr)
+	{
+		sunder_initialize_buffer(block.buffer, capacity, 0, capacity);
+		block.result = SUNDER_ARENA_RESULT_SUCCESS;
+	}
+
+	return block;
+}
+
+SUNDER_INTERNAL void sunder_free_arena_block_internal(u32 flags, u8** block, u64 capacity)
+{
+	if (*block == nullptr) { return; }
+
+	if (sunder_is_arena_memory_mapped_internal(flags))
+	{
+		sunder_release_virtual_memory_internal(*block, capacity);
+		*block = nullptr;
+		return;
+	}
+
+	sunder_aligned_free((void**)block);
+}
+
+// every block a tagged arena allocates is charged to its tag, chained and converged ones included
+SUNDER_INTERNAL void sunder_track_arena_block_internal(sunder_arena_t* arena, u64 capacity)
+{
+#if defined(SUNDER_ALLOCATION_TRACKING)
+	if (arena->allocation_tag == UINT32_MAX) { return; }
+
+	arena->allocation_tag_bytes += capacity;
+	sunder_track_allocation_internal(arena->allocation_tag, capacity, capacity);
+#else
+	(void)arena;
+	(void)capacity;
+#endif
+}
+
+SUNDER_INTERNAL void sunder_untrack_arena_block_internal(sunder_arena_t* arena, u64 capacity)
+{
+#if defined(SUNDER_ALLOCATION_TRACKING)
+	if (arena->allocation_tag == UINT32_MAX) { return; }
+
+	arena->allocation_tag_bytes -= capacity;
+	sunder_track_free_internal(arena->allocation_tag, capacity);
+#else
+	(void)arena;
+	(void)capacity;
+#endif
+}
+
+SUNDER_INTERNAL void sunder_install_arena_block_internal(sunder_arena_t* arena, const sunder_arena_block_t& block)
+{
+	arena->buffer = block.buffer;
+	arena->capacity = block.capacity;
+	arena->offset = 0;
+	arena->committed = block.committed;
+	arena->page_size = block.page_size;
+}
+
+// slow path of suballocation, only ever reached by the virtual memory backend since other blocks are committed as a whole
+SUNDER_INTERNAL sunder_arena_result sunder_commit_arena_internal(sunder_arena_t* arena, u64 required_offset)
+{
+	// huge page backed blocks commit whole pages so the os can keep using huge pages for them
+	const u64 granularity = arena->page_size > SUNDER_ARENA_VIRTUAL_MEMORY_COMMIT_GRANULARITY ? arena->page_size : SUNDER_ARENA_VIRTUAL_MEMORY_COMMIT_GRANULARITY;
+	u64 new_committed = sunder_align64(required_offset, granularity);
+	if (new_committed > arena->capacity) { new_committed = arena->capacity; }
+
+	if (!sunder_commit_virtual_memory_internal(arena->buffer + arena->committed, new_committed - arena->committed))
+	{
+		return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE;
+	}
+
+	arena->committed = new_committed;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL sunder_arena_result sunder_chain_arena_block_internal(sunder_arena_t* arena, u64 min_capacity)
+{
+	if (!(SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_ALLOW_CHAINING_BIT, 1u))) { return SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY; }
+
+	const u64 block_capacity = arena->capacity > min_capacity ? arena->capacity : min_capacity;
+
+	sunder_arena_t* retired_block = (sunder_arena_t*)sunder_halloc(sizeof(sunder_arena_t));
+	if (retired_block == nullptr) { return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE; }
+
+	const sunder_arena_block_t block = sunder_allocate_arena_block_internal(arena->flags, arena->allocation_alignment, block_capacity);
+
+	if (block.buffer == nullptr)
+	{
+		sunder_free((void**)&retired_block);
+		return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE;
+	}
+
+	*retired_block = sunder_arena_t{};
+	retired_block->buffer = arena->buffer;
+	retired_block->capacity = arena->capacity;
+	retired_block->offset = arena->offset;
+	retired_block->committed = arena->committed;
+	retired_block->page_size = arena->page_size;
+	retired_block->chain = arena->chain;
+	retired_block->chain_count = arena->chain_count;
+
+	sunder_install_arena_block_internal(arena, block);
+	sunder_track_arena_block_internal(arena, arena->capacity);
+	arena->chain = retired_block;
+	arena->chain_count++;
+	arena->retired_bytes += retired_block->offset;
+	sunder_clear_free_blocks_internal(arena);
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL void sunder_free_arena_chain_internal(sunder_arena_t* arena)
+{
+	sunder_arena_t* block = arena->chain;
+
+	while (block != nullptr)
+	{
+		sunder_arena_t* next_block = block->chain;
+		sunder_untrack_arena_block_internal(arena, block->capacity);
+		sunder_free_arena_block_internal(arena->flags, &block->buffer, block->capacity);
+		sunder_free((void**)&block);
+		block = next_block;
+	}
+
+	arena->chain = nullptr;
+	arena->chain_count = 0;
+	arena->retired_bytes = 0;
+}
+
+// bytes handed out across the active block and every chained block, padding included
+SUNDER_INTERNAL u64 sunder_get_arena_used_bytes_internal(const sunder_arena_t* arena)
+{
+	return arena->offset + arena->retired_bytes;
+}
+
+SUNDER_INTERNAL void sunder_update_arena_high_water_mark_internal(sunder_arena_t* arena)
+{
+	const u64 used_bytes = sunder_get_arena_used_bytes_internal(arena);
+	if (used_bytes > arena->statistics.high_water_mark) { arena->statistics.high_water_mark = used_bytes; }
+}
+
+SUNDER_INTERNAL void sunder_record_suballocation_internal(sunder_arena_t* arena, u64 bytes, u64 padding_bytes)
+{
+	arena->statistics.allocation_count++;
+	arena->statistics.bytes_requested += bytes;
+	arena->statistics.padding_bytes += padding_bytes;
+	sunder_update_arena_high_water_mark_internal(arena);
+}
+
+// a suballocation grown in place counts as the extra bytes being requested, not as another allocation
+SUNDER_INTERNAL void sunder_record_in_place_growth_internal(sunder_arena_t* arena, u64 grown_bytes)
+{
+	arena->statistics.bytes_requested += grown_bytes;
+	sunder_update_arena_high_water_mark_internal(arena);
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_arena_internal(sunder_arena_t* arena, u64 bytes, u32 alignment)
+{
+	sunder_arena_suballocation_result_t res;
+	const u64 working_alignment = sunder_clamp_u32(SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, alignment);
+
+	u64 aligned_offset = 0;
+
+	// while a marker is outstanding only the bump region is used, a free block carved now could not be handed back by the rollback
+	const sunder_arena_result free_block_result = arena->free_block_count > 0 && arena->marker_depth == 0 ? sunder_suballocate_from_free_blocks_internal(arena, bytes, working_alignment, &aligned_offset) : SUNDER_ARENA_RESULT_FAILURE;
+
+	if (free_block_result == SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		sunder_record_suballocation_internal(arena, bytes, 0);
+
+		res.result = SUNDER_ARENA_RESULT_SUCCESS;
+		res.data = &arena->buffer[aligned_offset];
+		return res;
+	}
+
+	if (free_block_result != SUNDER_ARENA_RESULT_FAILURE)
+	{
+		arena->statistics.out_of_memory_count++;
+		res.result = free_block_result;
+		return res;
+	}
+
+	aligned_offset = sunder_align64(arena->offset, working_alignment);
+	u64 post_suballocation_offset = aligned_offset + bytes;
+
+	if (post_suballocation_offset > arena->capacity)
+	{
+		res.result = sunder_chain_arena_block_internal(arena, bytes);
+
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS)
+		{
+			arena->statistics.out_of_memory_count++;
+			return res;
+		}
+
+		aligned_offset = 0;
+		post_suballocation_offset = bytes;
+	}
+
+	if (post_suballocation_offset > arena->committed)
+	{
+		res.result = sunder_commit_arena_internal(arena, post_suballocation_offset);
+
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS)
+		{
+			arena->statistics.out_of_memory_count++;
+			return res;
+		}
+	}
+
+	// padding is kept track of so that freed neighbours can still coalesce across it, the node for it is reserved before anything changes
+	const bool records_padding = aligned_offset > arena->offset && SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT, 1u);
+
+	if (records_padding)
+	{
+		res.result = sunder_reserve_free_block_nodes_internal(arena, 1);
+
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS)
+		{
+			arena->statistics.out_of_memory_count++;
+			return res;
+		}
+	}
+
+	void* data = &arena->buffer[aligned_offset];
+	const u64 previous_offset = arena->offset;
+	arena->offset = post_suballocation_offset;
+
+	if (records_padding)
+	{
+		sunder_arena_free_memory_block_t padding_block;
+		padding_block.suballocation_starting_offset = previous_offset;
+		padding_block.suballocation_size = aligned_offset - previous_offset;
+		sunder_release_free_block_internal(arena, padding_block);
+	}
+
+	sunder_record_suballocation_internal(arena, bytes, aligned_offset - previous_offset);
+
+	res.result = SUNDER_ARENA_RESULT_SUCCESS;
+	res.data = data;
+	return res;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_arena_concurrent_internal(sunder_arena_t* arena, u64 bytes, u32 alignment)
+{
+	sunder_arena_suballocation_result_t res;
+	const u64 working_alignment = sunder_clamp_u32(SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, alignment);
+
+	volatile u64* shared_offset = &arena->offset;
+	u64 current_offset = sunder_atomic_load_u64_internal(shared_offset);
+	u64 aligned_offset = 0;
+	u64 post_suballocation_offset = 0;
+
+	do
+	{
+		aligned_offset = sunder_align64(current_offset, working_alignment);
+		post_suballocation_offset = aligned_offset + bytes;
+
+		res.result = SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY;
+
+		if (post_suballocation_offset > arena->capacity)
+		{
+			sunder_atomic_add_u64_internal(&arena->statistics.out_of_memory_count, 1);
+			return res;
+		}
+	}
+	while (!sunder_atomic_compare_exchange_u64_internal(shared_offset, &current_offset, post_suballocation_offset));
+
+	volatile u64* shared_committed = &arena->committed;
+	u64 committed = sunder_atomic_load_u64_internal(shared_committed);
+
+	if (post_suballocation_offset > committed)
+	{
+		// racing committers may map overlapping ranges, committing is idempotent so the only shared state is the high water mark
+		const u64 granularity = arena->page_size > SUNDER_ARENA_VIRTUAL_MEMORY_COMMIT_GRANULARITY ? arena->page_size : SUNDER_ARENA_VIRTUAL_MEMORY_COMMIT_GRANULARITY;
+		u64 new_committed = sunder_align64(post_suballocation_offset, granularity);
+		if (new_committed > arena->capacity) { new_committed = arena->capacity; }
+
+		if (!sunder_commit_virtual_memory_internal(arena->buffer + committed, new_committed - committed))
+		{
+			sunder_atomic_add_u64_internal(&arena->statistics.out_of_memory_count, 1);
+			res.result = SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE;
+			return res;
+		}
+
+		while (committed < new_committed && !sunder_atomic_compare_exchange_u64_internal(shared_committed, &committed, new_committed)) {}
+	}
+
+	sunder_atomic_add_u64_internal(&arena->statistics.allocation_count, 1);
+	sunder_atomic_add_u64_internal(&arena->statistics.bytes_requested, bytes);
+	sunder_atomic_add_u64_internal(&arena->statistics.padding_bytes, aligned_offset - current_offset);
+	sunder_atomic_max_u64_internal(&arena->statistics.high_water_mark, post_suballocation_offset + arena->retired_bytes);
+
+	res.result = SUNDER_ARENA_RESULT_SUCCESS;
+	res.data = &arena->buffer[aligned_offset];
+	return res;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_arena_debug_internal(sunder_arena_t* arena, u64 bytes, u32 alignment)
+{
+	sunder_arena_suballocation_result_t res;
+	res.data = nullptr;
+	
+	const u32 working_alignment = sunder_clamp_u32(SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, alignment);
+
+	std::cout << "\n" << arena->offset << "/" << arena->capacity;
+	std::cout << "\nrequested alignment: " << alignment;
+	std::cout << "\nworking alignment: " << working_alignment;
+	std::cout << "\nallocating " << bytes << " bytes";
+	std::cout << "\ncurrent offset: " << arena->offset;
+
+	u64 aligned_offset = 0;
+	const sunder_arena_result free_block_result = arena->free_block_count > 0 && arena->marker_depth == 0 ? sunder_suballocate_from_free_blocks_internal(arena, bytes, working_alignment, &aligned_offset) : SUNDER_ARENA_RESULT_FAILURE;
+
+	if (free_block_result != SUNDER_ARENA_RESULT_SUCCESS && free_block_result != SUNDER_ARENA_RESULT_FAILURE)
+	{
+		SUNDER_LOG("\nfailed to grow the free block buffer\n");
+
+		arena->statistics.out_of_memory_count++;
+		res.result = free_block_result;
+		return res;
+	}
+
+	if (free_block_result == SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		SUNDER_LOG("\ndata assigned offset (reused free block): ");
+		SUNDER_LOG(aligned_offset);
+		SUNDER_LOG("\nfree block count: ");
+		SUNDER_LOG(arena->free_block_count);
+		SUNDER_LOG("\n");
+
+		sunder_record_suballocation_internal(arena, bytes, 0);
+
+		res.result = SUNDER_ARENA_RESULT_SUCCESS;
+		res.data = &arena->buffer[aligned_offset];
+		return res;
+	}
+
+	aligned_offset = sunder_align64(arena->offset, working_alignment);
+	u64 bytes_of_padding = aligned_offset - arena->offset;
+	u64 post_suballocation_offset = aligned_offset + bytes;
+
+	if (post_suballocation_offset > arena->capacity)
+	{
+		res.result = sunder_chain_arena_block_internal(arena, bytes);
+
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS)
+		{
+			arena->statistics.out_of_memory_count++;
+			return res;
+		}
+
+		SUNDER_LOG("\nchained new block of ");
+		SUNDER_LOG(arena->capacity);
+		SUNDER_LOG(" bytes, chain count: ");
+		SUNDER_LOG(arena->chain_count);
+
+		aligned_offset = 0;
+		bytes_of_padding = 0;
+		post_suballocation_offset = bytes;
+	}
+
+	if (post_suballocation_offset > arena->committed)
+	{
+		res.result = sunder_commit_arena_internal(arena, post_suballocation_offset);
+
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS)
+		{
+			arena->statistics.out_of_memory_count++;
+			return res;
+		}
+
+		SUNDER_LOG("\ncommitted: ");
+		SUNDER_LOG(arena->committed);
+	}
+
+	SUNDER_LOG("\ndata assigned offset: ");
+	SUNDER_LOG(aligned_offset);
+	SUNDER_LOG("\nbytes of padding added: ");
+	SUNDER_LOG(bytes_of_padding);
+	SUNDER_LOG("\npost suballocation offset: ");
+	SUNDER_LOG(post_suballocation_offset);
+	SUNDER_LOG("\n");
+
+	const bool records_padding = bytes_of_padding > 0 && SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT, 1u);
+
+	if (records_padding)
+	{
+		res.result = sunder_reserve_free_block_nodes_internal(arena, 1);
+
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS)
+		{
+			arena->statistics.out_of_memory_count++;
+			return res;
+		}
+	}
+
+	void* user_block = &arena->buffer[aligned_offset];
+
+	const u64 previous_offset = arena->offset;
+	arena->offset = post_suballocation_offset;
+
+	if (records_padding)
+	{
+		sunder_arena_free_memory_block_t padding_block;
+		padding_block.suballocation_starting_offset = previous_offset;
+		padding_block.suballocation_size = bytes_of_padding;
+		sunder_release_free_block_internal(arena, padding_block);
+	}
+
+	sunder_record_suballocation_internal(arena, bytes, bytes_of_padding);
+
+	res.result = SUNDER_ARENA_RESULT_SUCCESS;
+	res.data = user_block;
+
+	return res;
+}
+
+sunder_arena_result sunder_converge_arena_chain_debug(sunder_arena_t* arena)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+
+	SUNDER_LOG("\nconverging arena chain of ");
+	SUNDER_LOG(arena->chain_count);
+	SUNDER_LOG(" retired blocks");
+	SUNDER_LOG("\nactive block: ");
+	SUNDER_LOG(arena->offset);
+	SUNDER_LOG("/");
+	SUNDER_LOG(arena->capacity);
+
+	for (const sunder_arena_t* block = arena->chain; block != nullptr; block = block->chain)
+	{
+		SUNDER_LOG("\nretired block: ");
+		SUNDER_LOG(block->offset);
+		SUNDER_LOG("/");
+		SUNDER_LOG(block->capacity);
+	}
+
+	const sunder_arena_result res = sunder_converge_arena_chain(arena);
+
+	SUNDER_LOG("\nconverged capacity: ");
+	SUNDER_LOG(arena->capacity);
+	SUNDER_LOG("\n");
+
+	return res;
+}
+
+sunder_arena_result sunder_converge_arena_chain(sunder_arena_t* arena)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+
+	sunder_clear_free_blocks_internal(arena);
+	arena->marker_depth = 0;
+
+	if (arena->chain_count == 0)
+	{
+		arena->offset = 0;
+		return SUNDER_ARENA_RESULT_SUCCESS;
+	}
+
+	const u64 used_bytes = sunder_get_arena_used_bytes_internal(arena);
+	u64 converged_capacity = sunder_align64(used_bytes, arena->allocation_alignment);
+	if (converged_capacity < arena->capacity) { converged_capacity = arena->capacity; }
+
+	const sunder_arena_block_t converged_block = sunder_allocate_arena_block_internal(arena->flags, arena->allocation_alignment, converged_capacity);
+	if (converged_block.buffer == nullptr) { return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE; }
+
+	// the tag stays, the converged block is charged to it in place of the blocks it replaces
+	sunder_free_arena_chain_internal(arena);
+	sunder_untrack_arena_block_internal(arena, arena->capacity);
+	sunder_free_arena_block_internal(arena->flags, &arena->buffer, arena->capacity);
+	sunder_install_arena_block_internal(arena, converged_block);
+	sunder_track_arena_block_internal(arena, arena->capacity);
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL sunder_arena_t* sunder_registered_arenas = nullptr;
+SUNDER_INTERNAL sunder_mutex_t sunder_arena_registry_mutex;
+
+sunder_arena_result sunder_allocate_arena(sunder_arena_t* arena, u64 capacity, u32 arena_alignment)
+{
+	sunder_arena_allocation_data_t allocation_data;
+	allocation_data.arena_allocation_size = capacity;
+	allocation_data.arena_allocation_alignment = arena_alignment;
+
+	return sunder_allocate_arena(arena, &allocation_data);
+}
+
+sunder_arena_result sunder_allocate_arena(sunder_arena_t* arena, const sunder_arena_allocation_data_t* allocation_data)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+
+	const u64 capacity = allocation_data->arena_allocation_size;
+	const u32 arena_alignment = allocation_data->arena_allocation_alignment;
+
+	if (capacity == 0)
+	{
+		return SUNDER_ARENA_RESULT_FAILURE;
+	}
+
+	if (!sunder_is_valid_arena_alignment_internal(arena_alignment))
+	{
+		return SUNDER_ARENA_RESULT_FAILURE;
+	}
+
+	arena->free_block_nodes = nullptr;
+	arena->free_block_capacity = 0;
+	arena->free_block_unused_node = SUNDER_ARENA_FREE_BLOCK_NONE;
+	sunder_clear_free_blocks_internal(arena);
+
+	if (SUNDER_IS_ANY_BIT_SET(allocation_data->flags, SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT, 1u))
+	{
+		const u32 free_block_capacity = allocation_data->free_buffer_element_count > 0 ? allocation_data->free_buffer_element_count : SUNDER_DEFAULT_ARENA_FREE_BUFFER_ELEMENT_COUNT;
+
+		const sunder_arena_result reserve_result = sunder_reserve_free_block_nodes_internal(arena, free_block_capacity);
+		if (reserve_result != SUNDER_ARENA_RESULT_SUCCESS) { return reserve_result; }
+	}
+
+	const sunder_arena_block_t block = sunder_allocate_arena_block_internal(allocation_data->flags, arena_alignment, capacity);
+
+	if (block.buffer == nullptr)
+	{
+		sunder_free((void**)&arena->free_block_nodes);
+		arena->free_block_capacity = 0;
+		return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE; 
+	}
+
+	sunder_install_arena_block_internal(arena, block);
+	arena->chain = nullptr;
+	arena->chain_count = 0;
+	arena->marker_depth = 0;
+	arena->retired_bytes = 0;
+	arena->statistics = sunder_arena_statistics_t{};
+	arena->allocation_alignment = arena_alignment;
+	arena->flags = allocation_data->flags;
+
+	if (SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_REGISTER_STATISTICS_BIT, 1u))
+	{
+		std::lock_guard<std::mutex> lock(sunder_arena_registry_mutex.mutex);
+
+		arena->previous_registered = nullptr;
+		arena->next_registered = sunder_registered_arenas;
+		if (sunder_registered_arenas != nullptr) { sunder_registered_arenas->previous_registered = arena; }
+		sunder_registered_arenas = arena;
+	}
+
+	return block.result;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_arena(sunder_arena_t* arena, u64 bytes, u32 alignment)
+{
+	return sunder_suballocate_from_arena_internal(arena, bytes, alignment);
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_arena_concurrent(sunder_arena_t* arena, u64 bytes, u32 alignment)
+{
+	return sunder_suballocate_from_arena_concurrent_internal(arena, bytes, alignment);
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_arena_debug(sunder_arena_t* arena, u64 bytes, u32 alignment)
+{
+	return sunder_suballocate_from_arena_debug_internal(arena, bytes, alignment);
+}
+
+sunder_arena_result sunder_free_arena(sunder_arena_t* arena)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+
+	if (SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_REGISTER_STATISTICS_BIT, 1u))
+	{
+		std::lock_guard<std::mutex> lock(sunder_arena_registry_mutex.mutex);
+
+		if (arena->previous_registered != nullptr) { arena->previous_registered->next_registered = arena->next_registered; }
+		else { sunder_registered_arenas = arena->next_registered; }
+		if (arena->next_registered != nullptr) { arena->next_registered->previous_registered = arena->previous_registered; }
+
+		arena->next_registered = nullptr;
+		arena->previous_registered = nullptr;
+	}
+
+	sunder_free_arena_chain_internal(arena);
+	sunder_untrack_arena_block_internal(arena, arena->capacity);
+	sunder_free_arena_block_internal(arena->flags, &arena->buffer, arena->capacity);
+
+#if defined(SUNDER_ALLOCATION_TRACKING)
+	arena->allocation_tag = UINT32_MAX;
+#endif
+
+	arena->offset = 0;
+	arena->capacity = 0;
+	arena->committed = 0;
+	arena->page_size = 0;
+
+	sunder_free((void**)&arena->free_block_nodes);
+	arena->free_block_capacity = 0;
+	sunder_clear_free_blocks_internal(arena);
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_result sunder_reset_arena(sunder_arena_t* arena)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+
+	sunder_free_arena_chain_internal(arena);
+
+	arena->offset = 0;
+	arena->marker_depth = 0;
+	sunder_clear_free_blocks_internal(arena);
+
+	if (sunder_is_arena_memory_mapped_internal(arena->flags) && arena->committed > 0)
+	{
+#if defined(_WIN32)
+		VirtualFree(arena->buffer, arena->committed, MEM_DECOMMIT);
+		arena->committed = 0;
+#else
+		// dropping the pages of a private file mapping would bring the file contents back, the snapshot is swapped for anonymous memory instead
+		if (SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_SNAPSHOT_FILE_MAPPING_BIT, 1u))
+		{
+			if (mmap(arena->buffer, arena->committed, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) { return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE; }
+
+			SUNDER_ZERO_BIT(arena->flags, SUNDER_ARENA_BITS_SNAPSHOT_FILE_MAPPING_BIT, 1u);
+			return SUNDER_ARENA_RESULT_SUCCESS;
+		}
+
+		// pages stay accessible, the next touch faults in a fresh zeroed page
+		madvise(arena->buffer, arena->committed, MADV_DONTNEED);
+#endif
+	}
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+u64 sunder_get_arena_page_size(const sunder_arena_t* arena)
+{
+	if (arena == nullptr) { return 0; }
+
+	return arena->page_size;
+}
+
+sunder_arena_statistics_t sunder_query_arena_statistics(const sunder_arena_t* arena)
+{
+	sunder_arena_statistics_t statistics;
+	if (arena == nullptr) { return statistics; }
+
+	// counters may be bumped concurrently, every field is read atomically on its own
+	statistics.allocation_count = sunder_atomic_load_u64_internal(&arena->statistics.allocation_count);
+	statistics.bytes_requested = sunder_atomic_load_u64_internal(&arena->statistics.bytes_requested);
+	statistics.padding_bytes = sunder_atomic_load_u64_internal(&arena->statistics.padding_bytes);
+	statistics.high_water_mark = sunder_atomic_load_u64_internal(&arena->statistics.high_water_mark);
+	statistics.out_of_memory_count = sunder_atomic_load_u64_internal(&arena->statistics.out_of_memory_count);
+
+	return statistics;
+}
+
+sunder_arena_statistics_t sunder_query_global_arena_statistics()
+{
+	sunder_arena_statistics_t global_statistics;
+
+	std::lock_guard<std::mutex> lock(sunder_arena_registry_mutex.mutex);
+
+	for (const sunder_arena_t* arena = sunder_registered_arenas; arena != nullptr; arena = arena->next_registered)
+	{
+		const sunder_arena_statistics_t statistics = sunder_query_arena_statistics(arena);
+
+		global_statistics.allocation_count += statistics.allocation_count;
+		global_statistics.bytes_requested += statistics.bytes_requested;
+		global_statistics.padding_bytes += statistics.padding_bytes;
+		global_statistics.high_water_mark += statistics.high_water_mark;
+		global_statistics.out_of_memory_count += statistics.out_of_memory_count;
+	}
+
+	return global_statistics;
+}
+
+#if defined(SUNDER_ALLOCATION_TRACKING)
+void* sunder_halloc_tagged(u64 bytes, u32 tag)
+{
+	const u32 working_tag = sunder_get_allocation_tag_internal(tag);
+
+	// malloc alignment is kept since the header is 16 bytes
+	u8* block = (u8*)sunder_halloc(bytes + sizeof(sunder_allocation_tag_header_t));
+	if (block == nullptr) { return nullptr; }
+
+	sunder_allocation_tag_header_t* header = (sunder_allocation_tag_header_t*)block;
+	header->bytes = bytes;
+	header->tag = working_tag;
+	header->prefix_size = sizeof(sunder_allocation_tag_header_t);
+
+	sunder_track_allocation_internal(working_tag, bytes, bytes);
+
+	return block + sizeof(sunder_allocation_tag_header_t);
+}
+
+void sunder_free_tagged(void** memblock)
+{
+	if (memblock == nullptr || *memblock == nullptr) { return; }
+
+	const sunder_allocation_tag_header_t* header = (const sunder_allocation_tag_header_t*)((u8*)*memblock - sizeof(sunder_allocation_tag_header_t));
+	sunder_track_free_internal(header->tag, header->bytes);
+
+	void* block = (u8*)*memblock - header->prefix_size;
+	sunder_free(&block);
+	*memblock = nullptr;
+}
+
+void* sunder_aligned_halloc_tagged(u64 bytes, u64 alignment, u32 tag)
+{
+	if (alignment == 0) { return nullptr; }
+
+	const u32 working_tag = sunder_get_allocation_tag_internal(tag);
+	const u64 prefix_size = alignment < sizeof(sunder_allocation_tag_header_t) ? sizeof(sunder_allocation_tag_header_t) : alignment;
+
+	u8* block = (u8*)sunder_aligned_halloc(bytes + prefix_size, alignment);
+	if (block == nullptr) { return nullptr; }
+
+	sunder_allocation_tag_header_t* header = (sunder_allocation_tag_header_t*)(block + prefix_size - sizeof(sunder_allocation_tag_header_t));
+	header->bytes = bytes;
+	header->tag = working_tag;
+	header->prefix_size = (u32)prefix_size;
+
+	sunder_track_allocation_internal(working_tag, bytes, bytes);
+
+	return block + prefix_size;
+}
+
+void sunder_aligned_free_tagged(void** memblock)
+{
+	if (memblock == nullptr || *memblock == nullptr) { return; }
+
+	const sunder_allocation_tag_header_t* header = (const sunder_allocation_tag_header_t*)((u8*)*memblock - sizeof(sunder_allocation_tag_header_t));
+	sunder_track_free_internal(header->tag, header->bytes);
+
+	void* block = (u8*)*memblock - header->prefix_size;
+	sunder_aligned_free(&block);
+	*memblock = nullptr;
+}
+
+sunder_arena_result sunder_allocate_arena_tagged(sunder_arena_t* arena, const sunder_arena_allocation_data_t* allocation_data, u32 tag)
+{
+	const sunder_arena_result result = sunder_allocate_arena(arena, allocation_data);
+	if (arena == nullptr || arena->buffer == nullptr) { return result; }
+
+	arena->allocation_tag = sunder_get_allocation_tag_internal(tag);
+	arena->allocation_tag_bytes = arena->capacity;
+	sunder_track_allocation_internal(arena->allocation_tag, arena->capacity, arena->capacity);
+
+	return result;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_arena_tagged(sunder_arena_t* arena, u64 bytes, u32 alignment, u32 tag)
+{
+	const sunder_arena_suballocation_result_t res = sunder_suballocate_from_arena(arena, bytes, alignment);
+
+	// the arena itself is what owns the bytes, suballocations only show up in the call counts and the histogram
+	if (res.result == SUNDER_ARENA_RESULT_SUCCESS) { sunder_track_allocation_internal(sunder_get_allocation_tag_internal(tag), bytes, 0); }
+
+	return res;
+}
+
+void sunder_query_allocation_tag_statistics(sunder_allocation_tag_statistics_t* statistics)
+{
+	std::lock_guard<std::mutex> lock(sunder_allocation_tag_registry_mutex.mutex);
+
+	for (u32 tag = 0; tag < SUNDER_ALLOCATION_TAG_COUNT; tag++)
+	{
+		sunder_allocation_tag_statistics_t merged;
+		merged.live_bytes = sunder_atomic_load_u64_internal(&sunder_allocation_tag_live_bytes[tag]);
+		merged.peak_bytes = sunder_atomic_load_u64_internal(&sunder_allocation_tag_peak_bytes[tag]);
+		merged.allocation_count = sunder_allocation_tag_retired_table.allocation_counts[tag];
+		merged.free_count = sunder_allocation_tag_retired_table.free_counts[tag];
+
+		for (u32 bucket = 0; bucket < SUNDER_ALLOCATION_TAG_HISTOGRAM_BUCKET_COUNT; bucket++)
+		{
+			merged.size_histogram[bucket] = sunder_allocation_tag_retired_table.size_histograms[tag][bucket];
+		}
+
+		for (const sunder_allocation_tag_thread_table_t* table = sunder_allocation_tag_thread_tables; table != nullptr; table = table->next)
+		{
+			merged.allocation_count += sunder_atomic_load_u64_internal(&table->allocation_counts[tag]);
+			merged.free_count += sunder_atomic_load_u64_internal(&table->free_counts[tag]);
+
+			for (u32 bucket = 0; bucket < SUNDER_ALLOCATION_TAG_HISTOGRAM_BUCKET_COUNT; bucket++)
+			{
+				merged.size_histogram[bucket] += sunder_atomic_load_u64_internal(&table->size_histograms[tag][bucket]);
+			}
+		}
+
+		statistics[tag] = merged;
+	}
+}
+#endif
+
+
+sunder_arena_marker_t sunder_get_arena_marker(sunder_arena_t* arena)
+{
+	sunder_arena_marker_t marker;
+	if (arena == nullptr) { return marker; }
+
+	marker.offset = arena->offset;
+	marker.chain_count = arena->chain_count;
+	marker.depth = ++arena->marker_depth;
+
+	return marker;
+}
+
+sunder_arena_result sunder_rollback_arena_to_marker(sunder_arena_t* arena, const sunder_arena_marker_t* marker)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+
+	// a default constructed marker, or one taken before the arena was reset / converged
+	if (marker == nullptr || marker->depth == 0 || marker->depth > arena->marker_depth) { return SUNDER_ARENA_RESULT_OUT_OF_ORDER_ROLLBACK; }
+
+#if !defined(NDEBUG)
+	if (marker->depth != arena->marker_depth || marker->chain_count > arena->chain_count) { return SUNDER_ARENA_RESULT_OUT_OF_ORDER_ROLLBACK; }
+#endif
+
+	arena->marker_depth = marker->depth - 1;
+
+	// blocks chained after the marker was taken go away entirely, the block that was active at that point becomes active again
+	while (arena->chain_count > marker->chain_count)
+	{
+		sunder_arena_t* retired_block = arena->chain;
+
+		sunder_untrack_arena_block_internal(arena, arena->capacity);
+		sunder_free_arena_block_internal(arena->flags, &arena->buffer, arena->capacity);
+
+		arena->buffer = retired_block->buffer;
+		arena->capacity = retired_block->capacity;
+		arena->offset = retired_block->offset;
+		arena->committed = retired_block->committed;
+		arena->page_size = retired_block->page_size;
+		arena->chain = retired_block->chain;
+		arena->chain_count = retired_block->chain_count;
+		arena->retired_bytes -= retired_block->offset;
+		sunder_clear_free_blocks_internal(arena);
+
+		sunder_free((void**)&retired_block);
+	}
+
+	if (arena->offset > marker->offset) { arena->offset = marker->offset; }
+
+	// free blocks past the marker no longer exist, one reaching up to it (freed inside the scope for example) is cut short
+	// and handed back to the bump region once no outer marker is left that the offset could drop below
+	while (arena->free_block_count > 0)
+	{
+		const u32 last = sunder_find_free_block_at_or_before_internal(arena, UINT64_MAX);
+		sunder_arena_free_memory_block_t last_block = arena->free_block_nodes[last].block;
+		if (last_block.suballocation_starting_offset + last_block.suballocation_size < arena->offset) { break; }
+
+		sunder_remove_free_block_internal(arena, last);
+
+		if (last_block.suballocation_starting_offset >= arena->offset) { continue; }
+
+		if (arena->marker_depth == 0)
+		{
+			arena->offset = last_block.suballocation_starting_offset;
+			continue;
+		}
+
+		// removing the block gave its node back, putting the shortened block in cannot fail
+		last_block.suballocation_size = arena->offset - last_block.suballocation_starting_offset;
+		sunder_insert_free_block_internal(arena, last_block);
+		break;
+	}
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_scope_t::sunder_arena_scope_t(sunder_arena_t* scoped_arena)
+{
+	arena = scoped_arena;
+	if (arena != nullptr) { marker = sunder_get_arena_marker(arena); }
+}
+
+sunder_arena_scope_t::~sunder_arena_scope_t()
+{
+	if (arena != nullptr) { sunder_rollback_arena_to_marker(arena, &marker); }
+}
+
+sunder_arena_result sunder_free_arena_suballocation(sunder_arena_t* arena, void* data, u64 bytes)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (!(SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT, 1u))) { return SUNDER_ARENA_RESULT_FAILURE; }
+	if (data == nullptr || bytes == 0) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const u8* block_ptr = (const u8*)data;
+	if (block_ptr < arena->buffer || block_ptr >= arena->buffer + arena->offset) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	sunder_arena_free_memory_block_t block;
+	block.suballocation_starting_offset = (u64)(block_ptr - arena->buffer);
+	block.suballocation_size = bytes;
+
+	if (block.suballocation_starting_offset + block.suballocation_size > arena->offset) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	return sunder_release_free_block_internal(arena, block);
+}
+
+sunder_arena_resize_result_t sunder_resize_arena_suballocation(sunder_arena_t* arena, void* data, u64 old_bytes, u64 new_bytes, u32 alignment)
+{
+	sunder_arena_resize_result_t res;
+
+	if (arena == nullptr) { res.result = SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; return res; }
+	if (arena->buffer == nullptr) { res.result = SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; return res; }
+	if (data == nullptr) { res.result = SUNDER_ARENA_RESULT_FAILURE; return res; }
+
+	if (new_bytes == old_bytes)
+	{
+		res.data = data;
+		res.path = SUNDER_ARENA_RESIZE_PATH_NONE;
+		return res;
+	}
+
+	const u8* block_ptr = (const u8*)data;
+	const bool in_active_block = block_ptr >= arena->buffer && block_ptr + old_bytes <= arena->buffer + arena->offset;
+	const bool free_buffer_usage = SUNDER_IS_ANY_BIT_SET(arena->flags, SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT, 1u);
+
+	if (in_active_block)
+	{
+		const u64 block_offset = (u64)(block_ptr - arena->buffer);
+		const u64 old_end = block_offset + old_bytes;
+		const u64 new_end = block_offset + new_bytes;
+
+		// shrinking at the offset while a marker is outstanding takes the free block path further down, the offset must not drop under the marker
+		if (old_end == arena->offset && new_end <= arena->capacity && (new_bytes > old_bytes || arena->marker_depth == 0))
+		{
+			if (new_end > arena->committed)
+			{
+				res.result = sunder_commit_arena_internal(arena, new_end);
+				if (res.result != SUNDER_ARENA_RESULT_SUCCESS) { return res; }
+			}
+
+			arena->offset = new_end;
+
+			if (new_bytes > old_bytes) { sunder_record_in_place_growth_internal(arena, new_bytes - old_bytes); }
+
+			res.data = data;
+			res.path = new_bytes > old_bytes ? SUNDER_ARENA_RESIZE_PATH_IN_PLACE_GROW : SUNDER_ARENA_RESIZE_PATH_IN_PLACE_SHRINK;
+			return res;
+		}
+
+		if (new_bytes <= old_bytes)
+		{
+			// without a free buffer the cut off tail simply stays unused until the arena is reset
+			if (free_buffer_usage && new_bytes < old_bytes)
+			{
+				sunder_arena_free_memory_block_t tail_block;
+				tail_block.suballocation_starting_offset = new_end;
+				tail_block.suballocation_size = old_bytes - new_bytes;
+				res.result = sunder_release_free_block_internal(arena, tail_block);
+				if (res.result != SUNDER_ARENA_RESULT_SUCCESS) { return res; }
+			}
+
+			res.data = data;
+			res.path = SUNDER_ARENA_RESIZE_PATH_IN_PLACE_SHRINK;
+			return res;
+		}
+
+		if (free_buffer_usage && arena->free_block_count > 0)
+		{
+			const u32 next = sunder_find_free_block_at_or_after_internal(arena, old_end);
+
+			if (next != SUNDER_ARENA_FREE_BLOCK_NONE && arena->free_block_nodes[next].block.suballocation_starting_offset == old_end && old_end + arena->free_block_nodes[next].block.suballocation_size >= new_end)
+			{
+				// the leftover reuses the node of the removed block, carving cannot run out of nodes here
+				sunder_carve_free_block_internal(arena, next, old_end, new_end - old_end);
+				sunder_record_in_place_growth_internal(arena, new_bytes - old_bytes);
+
+				res.data = data;
+				res.path = SUNDER_ARENA_RESIZE_PATH_IN_PLACE_GROW;
+				return res;
+			}
+		}
+	}
+
+	const sunder_arena_suballocation_result_t relocation = sunder_suballocate_from_arena_internal(arena, new_bytes, alignment);
+
+	if (relocation.result != SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		res.result = relocation.result;
+		return res;
+	}
+
+	sunder_buffer_copy_data_t copying_data;
+	copying_data.dst_size = new_bytes;
+	copying_data.src_size = old_bytes;
+	copying_data.bytes_to_write = old_bytes < new_bytes ? old_bytes : new_bytes;
+	sunder_copy_buffer(relocation.data, data, &copying_data);
+
+	// chaining may have retired the block the old data lives in, freeing it is only possible while it is still active
+	const bool still_in_active_block = block_ptr >= arena->buffer && block_ptr + old_bytes <= arena->buffer + arena->offset;
+	if (free_buffer_usage && still_in_active_block) { sunder_free_arena_suballocation(arena, data, old_bytes); }
+
+	res.data = relocation.data;
+	res.path = SUNDER_ARENA_RESIZE_PATH_RELOCATED;
+	return res;
+}
+
+u64 sunder_get_arena_pointer_offset(const sunder_arena_t* arena, const void* data)
+{
+	return (u64)((const u8*)data - arena->buffer);
+}
+
+void* sunder_get_arena_offset_pointer(const sunder_arena_t* arena, u64 offset)
+{
+	return arena->buffer + offset;
+}
+
+// long is 32 bits on windows, data offsets are seeked to with the 64 bit variants
+SUNDER_INTERNAL bool sunder_seek_snapshot_file_internal(FILE* file, u64 offset)
+{
+#if defined(_WIN32)
+	return _fseeki64(file, (__int64)offset, SEEK_SET) == 0;
+#else
+	return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+sunder_arena_result sunder_save_arena_snapshot(const sunder_arena_t* arena, const char* path)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (arena->chain_count > 0) { return SUNDER_ARENA_RESULT_FAILURE; }
+	if (!sunder_is_valid_arena_alignment_internal(arena->allocation_alignment)) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	sunder_arena_snapshot_header_t header;
+	header.alignment = arena->allocation_alignment;
+	header.capacity = arena->capacity;
+	header.offset = arena->offset;
+	header.checksum = sunder_compute_snapshot_checksum_internal(arena->buffer, arena->offset);
+
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr) { return SUNDER_ARENA_RESULT_SNAPSHOT_IO_FAILURE; }
+
+	// seeking past the header leaves zeros (or a hole) up to data_offset
+	bool written = fwrite(&header, 1, sizeof(header), file) == sizeof(header) && sunder_seek_snapshot_file_internal(file, header.data_offset);
+	if (written && arena->offset > 0) { written = fwrite(arena->buffer, 1, arena->offset, file) == arena->offset; }
+
+	if (fclose(file) != 0) { written = false; }
+
+	return written ? SUNDER_ARENA_RESULT_SUCCESS : SUNDER_ARENA_RESULT_SNAPSHOT_IO_FAILURE;
+}
+
+sunder_arena_result sunder_load_arena_snapshot(sunder_arena_t* arena, const char* path, u8 snapshot_flags)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+
+	FILE* file = fopen(path, "rb");
+	if (file == nullptr) { return SUNDER_ARENA_RESULT_SNAPSHOT_IO_FAILURE; }
+
+	sunder_arena_snapshot_header_t header;
+	const bool header_read = fread(&header, 1, sizeof(header), file) == sizeof(header);
+
+	const bool alignment_valid = sunder_is_valid_arena_alignment_internal(header.alignment);
+
+	if (!header_read || header.magic != SUNDER_ARENA_SNAPSHOT_MAGIC || header.version != SUNDER_ARENA_SNAPSHOT_VERSION || header.offset > header.capacity || header.data_offset != SUNDER_ARENA_SNAPSHOT_DATA_OFFSET || !alignment_valid)
+	{
+		fclose(file);
+		return SUNDER_ARENA_RESULT_SNAPSHOT_CORRUPTED;
+	}
+
+	const bool read_only = SUNDER_IS_ANY_BIT_SET(snapshot_flags, SUNDER_ARENA_SNAPSHOT_BITS_READ_ONLY_BIT, 1u);
+
+	sunder_arena_allocation_data_t allocation_data;
+	allocation_data.arena_allocation_size = read_only ? (header.offset > 0 ? header.offset : 1) : header.capacity;
+	allocation_data.arena_allocation_alignment = header.alignment;
+
+#if defined(_WIN32)
+	// no copy on write file mapping into a reservation we already own, the data is read into a regular arena instead
+	const sunder_arena_result arena_result = sunder_allocate_arena(arena, &allocation_data);
+	if (arena_result != SUNDER_ARENA_RESULT_SUCCESS) { fclose(file); return arena_result; }
+
+	const bool data_read = sunder_seek_snapshot_file_internal(file, header.data_offset) && fread(arena->buffer, 1, header.offset, file) == header.offset;
+	fclose(file);
+
+	if (!data_read)
+	{
+		sunder_free_arena(arena);
+		return SUNDER_ARENA_RESULT_SNAPSHOT_IO_FAILURE;
+	}
+#else
+	fclose(file);
+
+	allocation_data.flags = SUNDER_BIT_TO_MASK(SUNDER_ARENA_BITS_VIRTUAL_MEMORY_BACKEND_BIT, 1u);
+
+	const sunder_arena_result arena_result = sunder_allocate_arena(arena, &allocation_data);
+	if (arena_result != SUNDER_ARENA_RESULT_SUCCESS) { return arena_result; }
+
+	if (header.offset > 0)
+	{
+		const i32 descriptor = open(path, O_RDONLY);
+
+		if (descriptor < 0)
+		{
+			sunder_free_arena(arena);
+			return SUNDER_ARENA_RESULT_SNAPSHOT_IO_FAILURE;
+		}
+
+		// touching a mapped page past the end of a truncated file raises SIGBUS, the size is checked on the descriptor that gets mapped
+		struct stat file_status;
+
+		if (fstat(descriptor, &file_status) != 0 || (u64)file_status.st_size < header.data_offset || (u64)file_status.st_size - header.data_offset < header.offset)
+		{
+			close(descriptor);
+			sunder_free_arena(arena);
+			return SUNDER_ARENA_RESULT_SNAPSHOT_CORRUPTED;
+		}
+
+		const i32 protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+
+		// private mapping over the start of the reservation, writes stay in memory and never reach the file
+		void* mapping = mmap(arena->buffer, header.offset, protection, MAP_PRIVATE | MAP_FIXED, descriptor, (off_t)header.data_offset);
+		close(descriptor);
+
+		if (mapping == MAP_FAILED)
+		{
+			sunder_free_arena(arena);
+			return SUNDER_ARENA_RESULT_SNAPSHOT_IO_FAILURE;
+		}
+
+		SUNDER_SET_BIT(arena->flags, SUNDER_ARENA_BITS_SNAPSHOT_FILE_MAPPING_BIT, 1u);
+	}
+
+	// the last file page is mapped as a whole, committing resumes at the next page boundary
+	arena->committed = read_only ? arena->capacity : sunder_align64(header.offset, arena->page_size);
+	if (arena->committed > arena->capacity) { arena->committed = arena->capacity; }
+
+	// read only snapshots leave no room to suballocate, not even in the rest of the last page
+	if (read_only && header.offset > 0) { arena->capacity = header.offset; arena->committed = header.offset; }
+#endif
+
+	arena->offset = header.offset;
+	sunder_update_arena_high_water_mark_internal(arena);
+
+	if (SUNDER_IS_ANY_BIT_SET(snapshot_flags, SUNDER_ARENA_SNAPSHOT_BITS_VERIFY_CHECKSUM_BIT, 1u) && sunder_compute_snapshot_checksum_internal(arena->buffer, header.offset) != header.checksum)
+	{
+		sunder_free_arena(arena);
+		return SUNDER_ARENA_RESULT_SNAPSHOT_CORRUPTED;
+	}
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_result sunder_initialize_pool(sunder_pool_t* pool, sunder_arena_t* arena, u64 slot_size, u32 slot_alignment, u32 slots_per_block)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (slot_size == 0 || slots_per_block == 0) { return SUNDER_ARENA_RESULT_FAILURE; }
+	if (!sunder_is_power_of_2(slot_alignment)) { return SUNDER_ARENA_RESULT_INVALID_REQUESTED_ALIGNMENT; }
+
+	const u32 working_alignment = sunder_clamp_u32(alignof(void*), SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, slot_alignment);
+
+	pool->arena = arena;
+	pool->free_list = nullptr;
+	pool->block_cursor = nullptr;
+	pool->block_end = nullptr;
+	pool->slot_size = sunder_align64(slot_size > sizeof(void*) ? slot_size : sizeof(void*), working_alignment);
+	pool->slot_alignment = working_alignment;
+	pool->slots_per_block = slots_per_block;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+SUNDER_INTERNAL sunder_arena_result sunder_grow_pool_internal(sunder_pool_t* pool)
+{
+	const sunder_arena_suballocation_result_t block = sunder_suballocate_from_arena(pool->arena, pool->slot_size * pool->slots_per_block, pool->slot_alignment);
+	if (block.result != SUNDER_ARENA_RESULT_SUCCESS) { return block.result; }
+
+	pool->block_cursor = (u8*)block.data;
+	pool->block_end = pool->block_cursor + pool->slot_size * pool->slots_per_block;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_pool(sunder_pool_t* pool)
+{
+	sunder_arena_suballocation_result_t res;
+
+	if (pool->free_list != nullptr)
+	{
+		res.data = pool->free_list;
+		pool->free_list = *(void**)pool->free_list;
+		return res;
+	}
+
+	if (pool->block_cursor == pool->block_end)
+	{
+		res.result = sunder_grow_pool_internal(pool);
+		if (res.result != SUNDER_ARENA_RESULT_SUCCESS) { return res; }
+	}
+
+	res.data = pool->block_cursor;
+	pool->block_cursor += pool->slot_size;
+
+	return res;
+}
+
+void sunder_free_pool_slot(sunder_pool_t* pool, void* slot)
+{
+	if (slot == nullptr) { return; }
+
+	*(void**)slot = pool->free_list;
+	pool->free_list = slot;
+}
+
+u32 sunder_suballocate_from_pool_bulk(sunder_pool_t* pool, void** slots, u32 count)
+{
+	u32 written = 0;
+
+	while (written < count && pool->free_list != nullptr)
+	{
+		slots[written++] = pool->free_list;
+		pool->free_list = *(void**)pool->free_list;
+	}
+
+	while (written < count)
+	{
+		if (pool->block_cursor == pool->block_end && sunder_grow_pool_internal(pool) != SUNDER_ARENA_RESULT_SUCCESS) { break; }
+
+		const u64 slots_left_in_block = (u64)(pool->block_end - pool->block_cursor) / pool->slot_size;
+		const u64 slots_to_carve = slots_left_in_block < (u64)(count - written) ? slots_left_in_block : (u64)(count - written);
+
+		for (u64 i = 0; i < slots_to_carve; i++)
+		{
+			slots[written++] = pool->block_cursor;
+			pool->block_cursor += pool->slot_size;
+		}
+	}
+
+	return written;
+}
+
+void sunder_free_pool_slots_bulk(sunder_pool_t* pool, void* const* slots, u32 count)
+{
+	if (count == 0) { return; }
+
+	// link the array up front, then splice the whole chain onto the free list at once
+	for (u32 i = 0; i < count - 1; i++)
+	{
+		*(void**)slots[i] = slots[i + 1];
+	}
+
+	*(void**)slots[count - 1] = pool->free_list;
+	pool->free_list = slots[0];
+}
+
+void sunder_initialize_pool_thread_cache(sunder_pool_thread_cache_t* cache, sunder_pool_t* pool)
+{
+	cache->pool = pool;
+	cache->slot_count = 0;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_pool_thread_cache(sunder_pool_thread_cache_t* cache)
+{
+	sunder_arena_suballocation_result_t res;
+
+	if (cache->slot_count == 0)
+	{
+		std::lock_guard<std::mutex> lock(cache->pool->mutex.mutex);
+		cache->slot_count = sunder_suballocate_from_pool_bulk(cache->pool, cache->slots, SUNDER_POOL_THREAD_CACHE_CAPACITY / 2);
+	}
+
+	res.result = SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY;
+	if (cache->slot_count == 0) { return res; }
+
+	res.result = SUNDER_ARENA_RESULT_SUCCESS;
+	res.data = cache->slots[--cache->slot_count];
+
+	return res;
+}
+
+void sunder_free_pool_slot_to_thread_cache(sunder_pool_thread_cache_t* cache, void* slot)
+{
+	if (slot == nullptr) { return; }
+
+	if (cache->slot_count == SUNDER_POOL_THREAD_CACHE_CAPACITY)
+	{
+		// hand back the older half, the most recently freed slots are the likeliest to still be in cache
+		std::lock_guard<std::mutex> lock(cache->pool->mutex.mutex);
+		sunder_free_pool_slots_bulk(cache->pool, cache->slots, SUNDER_POOL_THREAD_CACHE_CAPACITY / 2);
+
+		for (u32 i = 0; i < SUNDER_POOL_THREAD_CACHE_CAPACITY / 2; i++)
+		{
+			cache->slots[i] = cache->slots[i + SUNDER_POOL_THREAD_CACHE_CAPACITY / 2];
+		}
+
+		cache->slot_count = SUNDER_POOL_THREAD_CACHE_CAPACITY / 2;
+	}
+
+	cache->slots[cache->slot_count++] = slot;
+}
+
+void sunder_flush_pool_thread_cache(sunder_pool_thread_cache_t* cache)
+{
+	if (cache->slot_count == 0) { return; }
+
+	std::lock_guard<std::mutex> lock(cache->pool->mutex.mutex);
+	sunder_free_pool_slots_bulk(cache->pool, cache->slots, cache->slot_count);
+	cache->slot_count = 0;
+}
+
+sunder_arena_result sunder_initialize_frame_arena(sunder_frame_arena_t* frame_arena, sunder_arena_t* arena, u64 capacity, u32 frames_in_flight, u32 alignment)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (capacity == 0 || frames_in_flight == 0) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const sunder_arena_suballocation_result_t ring = sunder_suballocate_from_arena(arena, capacity, alignment);
+	if (ring.result != SUNDER_ARENA_RESULT_SUCCESS) { return ring.result; }
+
+	*frame_arena = sunder_frame_arena_t{};
+	frame_arena->buffer = (u8*)ring.data;
+	frame_arena->capacity = capacity;
+	frame_arena->frames_in_flight = frames_in_flight < SUNDER_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT ? frames_in_flight : SUNDER_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_result sunder_begin_frame_arena_frame(sunder_frame_arena_t* frame_arena, u64* frame_number)
+{
+	if (frame_arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (frame_arena->recording) { return SUNDER_ARENA_RESULT_FAILURE; }
+	if (frame_arena->next_frame - frame_arena->oldest_frame >= frame_arena->frames_in_flight) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const u32 slot = (u32)(frame_arena->next_frame % frame_arena->frames_in_flight);
+	frame_arena->frame_completed[slot] = false;
+	frame_arena->recording = true;
+
+	*frame_number = frame_arena->next_frame++;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_frame_arena(sunder_frame_arena_t* frame_arena, u64 bytes, u32 alignment)
+{
+	sunder_arena_suballocation_result_t res;
+
+	// outside of a frame nothing owns the memory, it would silently be recycled with whichever frame is recorded next
+	res.result = SUNDER_ARENA_RESULT_FAILURE;
+	if (!frame_arena->recording) { return res; }
+
+	const u64 working_alignment = sunder_clamp_u32(SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, alignment);
+
+	u64 lap_start = frame_arena->lap_start;
+	u64 aligned_offset = sunder_align64(frame_arena->head - lap_start, working_alignment);
+
+	// never split a suballocation across the end of the ring, the rest of the lap is skipped instead
+	if (aligned_offset + bytes > frame_arena->capacity)
+	{
+		lap_start += frame_arena->capacity;
+		aligned_offset = 0;
+	}
+
+	const u64 post_suballocation_head = lap_start + aligned_offset + bytes;
+
+	res.result = SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY;
+	if (post_suballocation_head - frame_arena->tail > frame_arena->capacity) { return res; }
+
+	frame_arena->head = post_suballocation_head;
+	frame_arena->lap_start = lap_start;
+
+	res.result = SUNDER_ARENA_RESULT_SUCCESS;
+	res.data = &frame_arena->buffer[aligned_offset];
+	return res;
+}
+
+sunder_arena_result sunder_end_frame_arena_frame(sunder_frame_arena_t* frame_arena)
+{
+	if (!frame_arena->recording) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const u32 slot = (u32)((frame_arena->next_frame - 1) % frame_arena->frames_in_flight);
+	frame_arena->frame_ends[slot] = frame_arena->head;
+	frame_arena->recording = false;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_result sunder_complete_frame_arena_frame(sunder_frame_arena_t* frame_arena, u64 frame_number)
+{
+	if (frame_number < frame_arena->oldest_frame || frame_number >= frame_arena->next_frame) { return SUNDER_ARENA_RESULT_FAILURE; }
+	if (frame_arena->recording && frame_number == frame_arena->next_frame - 1) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	frame_arena->frame_completed[frame_number % frame_arena->frames_in_flight] = true;
+
+	while (frame_arena->oldest_frame < frame_arena->next_frame)
+	{
+		const u32 slot = (u32)(frame_arena->oldest_frame % frame_arena->frames_in_flight);
+		if (!frame_arena->frame_completed[slot]) { break; }
+		if (frame_arena->recording && frame_arena->oldest_frame == frame_arena->next_frame - 1) { break; }
+
+		frame_arena->tail = frame_arena->frame_ends[slot];
+		frame_arena->oldest_frame++;
+	}
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_result sunder_initialize_buddy_allocator(sunder_buddy_allocator_t* buddy, sunder_arena_t* arena, u64 capacity, u64 min_block_size)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (!sunder_is_power_of_2(capacity) || !sunder_is_power_of_2(min_block_size) || min_block_size > capacity) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const u32 min_block_shift = sunder_log2_u64_internal(min_block_size);
+	const u32 max_order = sunder_log2_u64_internal(capacity) - min_block_shift;
+	if (max_order >= 255u) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const u64 node_count = (2ull << max_order) - 1;
+	const u32 region_alignment = min_block_size > SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT ? SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT : (u32)min_block_size;
+
+	const sunder_arena_suballocation_result_t region = sunder_suballocate_from_arena(arena, capacity, region_alignment);
+	if (region.result != SUNDER_ARENA_RESULT_SUCCESS) { return region.result; }
+
+	const sunder_arena_suballocation_result_t tree = sunder_suballocate_from_arena(arena, node_count, 1);
+	if (tree.result != SUNDER_ARENA_RESULT_SUCCESS) { return tree.result; }
+
+	*buddy = sunder_buddy_allocator_t{};
+	buddy->buffer = (u8*)region.data;
+	buddy->tree = (u8*)tree.data;
+	buddy->capacity = capacity;
+	buddy->min_block_size = min_block_size;
+	buddy->free_bytes = capacity;
+	buddy->min_block_shift = min_block_shift;
+	buddy->max_order = max_order;
+
+	// every node starts out as a whole free block of its level
+	u64 level_begin = 0;
+
+	for (u32 depth = 0; depth <= max_order; depth++)
+	{
+		const u64 level_node_count = 1ull << depth;
+		const u8 level_value = (u8)(max_order - depth + 1);
+
+		for (u64 i = 0; i < level_node_count; i++)
+		{
+			buddy->tree[level_begin + i] = level_value;
+		}
+
+		level_begin += level_node_count;
+	}
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_suballocation_result_t sunder_suballocate_from_buddy_allocator(sunder_buddy_allocator_t* buddy, u64 bytes)
+{
+	sunder_arena_suballocation_result_t res;
+	res.result = SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY;
+
+	if (bytes == 0 || bytes > buddy->capacity) { return res; }
+
+	const u64 block_size = bytes <= buddy->min_block_size ? buddy->min_block_size : 1ull << (sunder_log2_u64_internal(bytes - 1) + 1);
+	const u32 order = sunder_log2_u64_internal(block_size) - buddy->min_block_shift;
+
+	if (buddy->tree[0] < order + 1) { return res; }
+
+	u64 node = 0;
+	u32 node_order = buddy->max_order;
+
+	while (node_order != order)
+	{
+		const u64 left = node * 2 + 1;
+		node = buddy->tree[left] >= order + 1 ? left : left + 1;
+		node_order--;
+	}
+
+	buddy->tree[node] = 0;
+	sunder_update_buddy_ancestors_internal(buddy, node, order);
+
+	const u64 level_index = node + 1 - (1ull << (buddy->max_order - order));
+	buddy->free_bytes -= block_size;
+
+	res.data = buddy->buffer + (level_index << (order + buddy->min_block_shift));
+	res.result = SUNDER_ARENA_RESULT_SUCCESS;
+	return res;
+}
+
+sunder_arena_result sunder_free_buddy_allocator_block(sunder_buddy_allocator_t* buddy, void* data)
+{
+	const u8* block = (const u8*)data;
+	if (block < buddy->buffer || block >= buddy->buffer + buddy->capacity) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const u64 offset = (u64)(block - buddy->buffer);
+	if (sunder_align64(offset, buddy->min_block_size) != offset) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	// nodes below an allocated block are never touched, so the allocated node is the first 0 on the way up from the leaf
+	u64 node = (offset >> buddy->min_block_shift) + (1ull << buddy->max_order) - 1;
+	u32 order = 0;
+
+	while (buddy->tree[node] != 0)
+	{
+		if (node == 0) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+		node = (node - 1) / 2;
+		order++;
+	}
+
+	if (sunder_align64(offset, buddy->min_block_size << order) != offset) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	buddy->tree[node] = (u8)(order + 1);
+	sunder_update_buddy_ancestors_internal(buddy, node, order);
+
+	buddy->free_bytes += buddy->min_block_size << order;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+u64 sunder_get_buddy_allocator_largest_free_block(const sunder_buddy_allocator_t* buddy)
+{
+	return buddy->tree[0] == 0 ? 0 : buddy->min_block_size << (buddy->tree[0] - 1);
+}
+
+f32 sunder_get_buddy_allocator_fragmentation(const sunder_buddy_allocator_t* buddy)
+{
+	if (buddy->free_bytes == 0) { return 0.0f; }
+
+	return 1.0f - (f32)((f64)sunder_get_buddy_allocator_largest_free_block(buddy) / (f64)buddy->free_bytes);
+}
+
+sunder_arena_result sunder_allocate_handle_arena(sunder_handle_arena_t* handle_arena, u64 capacity, u32 arena_alignment, u32 handle_capacity)
+{
+	if (handle_arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (handle_capacity == 0) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	sunder_arena_allocation_data_t allocation_data;
+	allocation_data.arena_allocation_size = capacity;
+	allocation_data.arena_allocation_alignment = arena_alignment;
+	allocation_data.free_buffer_element_count = handle_capacity;
+	allocation_data.flags = SUNDER_BIT_TO_MASK(SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT, 1u);
+
+	const sunder_arena_result arena_result = sunder_allocate_arena(&handle_arena->arena, &allocation_data);
+	if (arena_result != SUNDER_ARENA_RESULT_SUCCESS) { return arena_result; }
+
+	handle_arena->entries = (sunder_arena_handle_entry_t*)sunder_halloc(sizeof(sunder_arena_handle_entry_t), handle_capacity);
+	handle_arena->live_entries = (u32*)sunder_halloc(sizeof(u32), handle_capacity);
+
+	if (handle_arena->entries == nullptr || handle_arena->live_entries == nullptr)
+	{
+		sunder_free_handle_arena(handle_arena);
+		return SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE;
+	}
+
+	handle_arena->entry_capacity = handle_capacity;
+	handle_arena->entry_count = 0;
+	handle_arena->live_count = 0;
+	handle_arena->free_entry_head = UINT32_MAX;
+	handle_arena->compaction_index = 0;
+	handle_arena->compacting = false;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_result sunder_free_handle_arena(sunder_handle_arena_t* handle_arena)
+{
+	if (handle_arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+
+	sunder_free((void**)&handle_arena->entries);
+	sunder_free((void**)&handle_arena->live_entries);
+	handle_arena->entry_capacity = 0;
+	handle_arena->entry_count = 0;
+	handle_arena->live_count = 0;
+	handle_arena->free_entry_head = UINT32_MAX;
+
+	if (handle_arena->arena.buffer == nullptr) { return SUNDER_ARENA_RESULT_SUCCESS; }
+
+	return sunder_free_arena(&handle_arena->arena);
+}
+
+sunder_arena_handle_suballocation_result_t sunder_suballocate_handle_from_arena(sunder_handle_arena_t* handle_arena, u64 bytes, u32 alignment)
+{
+	sunder_arena_handle_suballocation_result_t res;
+
+	if (handle_arena->free_entry_head == UINT32_MAX && handle_arena->entry_count == handle_arena->entry_capacity)
+	{
+		res.result = SUNDER_ARENA_RESULT_FAILURE;
+		return res;
+	}
+
+	const sunder_arena_suballocation_result_t suballocation = sunder_suballocate_from_arena(&handle_arena->arena, bytes, alignment);
+
+	if (suballocation.result != SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		res.result = suballocation.result;
+		return res;
+	}
+
+	u32 index = handle_arena->free_entry_head;
+
+	if (index != UINT32_MAX) { handle_arena->free_entry_head = handle_arena->entries[index].next_free_entry; }
+	else { index = handle_arena->entry_count++; handle_arena->entries[index].generation = 0; }
+
+	sunder_arena_handle_entry_t* entry = &handle_arena->entries[index];
+	entry->offset = (u64)((u8*)suballocation.data - handle_arena->arena.buffer);
+	entry->size = bytes;
+	entry->padding = 0;
+	entry->alignment = alignment;
+	entry->generation++;
+	if (entry->generation == 0) { entry->generation = 1; }
+	entry->live = true;
+
+	const u32 position = sunder_lower_bound_live_entry_internal(handle_arena, entry->offset);
+
+	for (u32 i = handle_arena->live_count; i > position; i--)
+	{
+		handle_arena->live_entries[i] = handle_arena->live_entries[i - 1];
+	}
+
+	handle_arena->live_entries[position] = index;
+	handle_arena->live_count++;
+
+	// keep the resume point on the same suballocation when one lands in the already compacted prefix
+	if (handle_arena->compacting && position < handle_arena->compaction_index) { handle_arena->compaction_index++; }
+
+	res.handle.index = index;
+	res.handle.generation = entry->generation;
+	return res;
+}
+
+sunder_arena_result sunder_free_arena_handle(sunder_handle_arena_t* handle_arena, sunder_arena_handle_t handle)
+{
+	if (handle.index >= handle_arena->entry_count) { return SUNDER_ARENA_RESULT_STALE_HANDLE; }
+
+	sunder_arena_handle_entry_t* entry = &handle_arena->entries[handle.index];
+	if (!entry->live || entry->generation != handle.generation) { return SUNDER_ARENA_RESULT_STALE_HANDLE; }
+
+	const sunder_arena_result result = sunder_free_arena_suballocation(&handle_arena->arena, handle_arena->arena.buffer + entry->offset, entry->size + entry->padding);
+	if (result != SUNDER_ARENA_RESULT_SUCCESS) { return result; }
+
+	const u32 position = sunder_lower_bound_live_entry_internal(handle_arena, entry->offset);
+
+	for (u32 i = position; i + 1 < handle_arena->live_count; i++)
+	{
+		handle_arena->live_entries[i] = handle_arena->live_entries[i + 1];
+	}
+
+	handle_arena->live_count--;
+
+	// a hole in the already compacted prefix is packed again by the running pass, so finishing it still leaves no free blocks
+	if (handle_arena->compacting && position < handle_arena->compaction_index) { handle_arena->compaction_index = position; }
+
+	entry->live = false;
+	entry->next_free_entry = handle_arena->free_entry_head;
+	handle_arena->free_entry_head = handle.index;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+void* sunder_resolve_arena_handle(const sunder_handle_arena_t* handle_arena, sunder_arena_handle_t handle)
+{
+	if (handle.index >= handle_arena->entry_count) { return nullptr; }
+
+	const sunder_arena_handle_entry_t* entry = &handle_arena->entries[handle.index];
+	if (!entry->live || entry->generation != handle.generation) { return nullptr; }
+
+	return handle_arena->arena.buffer + entry->offset;
+}
+
+sunder_arena_result sunder_compact_handle_arena(sunder_handle_arena_t* handle_arena, u64 byte_budget)
+{
+	sunder_arena_t* arena = &handle_arena->arena;
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+
+	if (!handle_arena->compacting)
+	{
+		handle_arena->compacting = true;
+		handle_arena->compaction_index = 0;
+	}
+
+	u64 moved_bytes = 0;
+
+	while (handle_arena->compaction_index < handle_arena->live_count)
+	{
+		const u32 position = handle_arena->compaction_index;
+		sunder_arena_handle_entry_t* entry = &handle_arena->entries[handle_arena->live_entries[position]];
+
+		sunder_arena_handle_entry_t* previous = nullptr;
+		u64 previous_end = 0;
+		if (position > 0)
+		{
+			previous = &handle_arena->entries[handle_arena->live_entries[position - 1]];
+			previous_end = previous->offset + previous->size;
+		}
+
+		const u64 working_alignment = sunder_clamp_u32(SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT, entry->alignment);
+		const u64 target_offset = sunder_align64(previous_end, working_alignment);
+
+		if (target_offset < entry->offset)
+		{
+			if (moved_bytes > 0 && moved_bytes + entry->size > byte_budget) { return SUNDER_ARENA_RESULT_COMPACTION_IN_PROGRESS; }
+
+			// the gap the previous suballocation holds goes back first, so everything between it and this one is one coalesced free block
+			if (previous != nullptr && previous->padding > 0)
+			{
+				sunder_arena_free_memory_block_t padding_block;
+				padding_block.suballocation_starting_offset = previous_end;
+				padding_block.suballocation_size = previous->padding;
+
+				const sunder_arena_result padding_result = sunder_release_free_block_internal(arena, padding_block);
+				if (padding_result != SUNDER_ARENA_RESULT_SUCCESS) { return padding_result; }
+
+				previous->padding = 0;
+			}
+
+			sunder_arena_free_memory_block_t old_block;
+			old_block.suballocation_starting_offset = entry->offset;
+			old_block.suballocation_size = entry->size + entry->padding;
+
+			const sunder_arena_result release_result = sunder_release_free_block_internal(arena, old_block);
+			if (release_result != SUNDER_ARENA_RESULT_SUCCESS) { return release_result; }
+
+			entry->padding = 0;
+
+			const sunder_arena_result claim_result = sunder_claim_free_range_internal(arena, target_offset, entry->size);
+
+			if (claim_result != SUNDER_ARENA_RESULT_SUCCESS)
+			{
+				// claiming only fails when the node pool cannot grow, taking the old range back is best effort
+				sunder_claim_free_range_internal(arena, entry->offset, entry->size);
+				return claim_result;
+			}
+
+			sunder_buffer_copy_data_t copying_data;
+			copying_data.dst_size = entry->size;
+			copying_data.src_size = entry->size;
+			copying_data.bytes_to_write = entry->size;
+			sunder_copy_buffer(arena->buffer + target_offset, arena->buffer + entry->offset, &copying_data);
+
+			entry->offset = target_offset;
+			moved_bytes += entry->size;
+		}
+
+		// whatever is still free in front of the suballocation is smaller than its alignment, the previous one takes it over
+		if (previous != nullptr && previous_end + previous->padding < entry->offset)
+		{
+			const sunder_arena_result gap_result = sunder_claim_free_range_internal(arena, previous_end + previous->padding, entry->offset - previous_end - previous->padding);
+			if (gap_result != SUNDER_ARENA_RESULT_SUCCESS) { return gap_result; }
+
+			previous->padding = entry->offset - previous_end;
+		}
+
+		handle_arena->compaction_index++;
+	}
+
+	// nothing follows the last suballocation any more, its gap would only keep the offset up
+	if (handle_arena->live_count > 0)
+	{
+		sunder_arena_handle_entry_t* last = &handle_arena->entries[handle_arena->live_entries[handle_arena->live_count - 1]];
+
+		if (last->padding > 0)
+		{
+			sunder_arena_free_memory_block_t padding_block;
+			padding_block.suballocation_starting_offset = last->offset + last->size;
+			padding_block.suballocation_size = last->padding;
+
+			const sunder_arena_result padding_result = sunder_release_free_block_internal(arena, padding_block);
+			if (padding_result != SUNDER_ARENA_RESULT_SUCCESS) { return padding_result; }
+
+			last->padding = 0;
+		}
+	}
+
+	handle_arena->compacting = false;
+	handle_arena->compaction_index = 0;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_arena_result sunder_initialize_uniform_ring(sunder_uniform_ring_t* ring, sunder_arena_t* arena, u64 segment_size, u32 segment_count, u64 min_offset_alignment)
+{
+	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (segment_count == 0 || !sunder_is_power_of_2(min_offset_alignment)) { return SUNDER_ARENA_RESULT_FAILURE; }
+
+	const u32 working_segment_count = segment_count < SUNDER_UNIFORM_RING_MAX_SEGMENTS ? segment_count : SUNDER_UNIFORM_RING_MAX_SEGMENTS;
+	const u64 aligned_segment_size = sunder_align64(segment_size, min_offset_alignment);
+
+	// offsets are relative to the ring, the buffer itself only gets the strongest alignment the arena hands out
+	const sunder_arena_suballocation_result_t segments = sunder_suballocate_from_arena(arena, aligned_segment_size * working_segment_count, SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT);
+	if (segments.result != SUNDER_ARENA_RESULT_SUCCESS) { return segments.result; }
+
+	*ring = sunder_uniform_ring_t{};
+	ring->buffer = (u8*)segments.data;
+	ring->capacity = aligned_segment_size * working_segment_count;
+	ring->segment_size = aligned_segment_size;
+	ring->min_offset_alignment = min_offset_alignment;
+	ring->segment_count = working_segment_count;
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+sunder_uniform_ring_suballocation_t sunder_suballocate_from_uniform_ring(sunder_uniform_ring_t* ring, u64 bytes)
+{
+	sunder_uniform_ring_suballocation_t res;
+	const u64 aligned_bytes = sunder_align64(bytes, ring->min_offset_alignment);
+
+	// sizes are padded up front so the cursor stays aligned, the cursor only moves when the request fits
+	// (a fetch add would leave a failed oversize request on the cursor and exhaust the segment for everyone else)
+	u64 segment_offset = sunder_atomic_load_u64_internal(&ring->cursor);
+
+	res.result = SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY;
+
+	do
+	{
+		if (aligned_bytes > ring->segment_size - segment_offset) { return res; }
+	} while (!sunder_atomic_compare_exchange_u64_internal(&ring->cursor, &segment_offset, segment_offset + aligned_bytes));
+
+	res.offset = (u64)ring->segment_index * ring->segment_size + segment_offset;
+	res.data = &ring->buffer[res.offset];
+	res.result = SUNDER_ARENA_RESULT_SUCCESS;
+	return res;
+}
+
+sunder_uniform_ring_suballocation_t sunder_suballocate_array_from_uniform_ring(sunder_uniform_ring_t* ring, u64 element_size, u64 element_count)
+{
+	return sunder_suballocate_from_uniform_ring(ring, sunder_align64(element_size, ring->min_offset_alignment) * element_count);
+}
+
+u32 sunder_flip_uniform_ring(sunder_uniform_ring_t* ring)
+{
+	ring->segment_index = (ring->segment_index + 1) % ring->segment_count;
+	ring->cursor = 0;
+
+	return ring->segment_index;
+}
+
+u64 sunder_get_aligned_struct_allocation_size_debug(const u64* alignment_buffer, const u64* allocation_size_buffer, u64 buffer_size, u64 struct_alignment)
+{
+	u64 offset = 0;
+	u64 aligned_offset = 0;
+	u64 bytes_of_padding = 0;
+
+	for (u64 i = 0; i < buffer_size; i++)
+	{
+		SUNDER_LOG("\nrequested alignment: ");
+		SUNDER_LOG(alignment_buffer[i]);
+		aligned_offset = sunder_align64(offset, alignment_buffer[i]);
+		SUNDER_LOG("\nallocating ");
+		SUNDER_LOG(allocation_size_buffer[i]);
+		SUNDER_LOG(" bytes");
+		SUNDER_LOG("\ncurrent offset: ");
+		SUNDER_LOG(offset);
+		SUNDER_LOG("\naligned offset: ");
+		SUNDER_LOG(aligned_offset);
+		bytes_of_padding = aligned_offset - offset;
+		SUNDER_LOG("\nbytes of padding added: ");
+		SUNDER_LOG(bytes_of_padding);
+		offset = aligned_offset + allocation_size_buffer[i];
+		SUNDER_LOG("\npost allocation offset: ");
+		SUNDER_LOG(offset);
+		SUNDER_LOG("\n");
+	}
+
+	SUNDER_LOG("\nrequested alignment: ");
+	SUNDER_LOG(struct_alignment);
+	SUNDER_LOG("\nallocating ");
+	SUNDER_LOG(0);
+	SUNDER_LOG(" bytes");
+	SUNDER_LOG("\ncurrent offset: ");
+	SUNDER_LOG(offset);
+	aligned_offset = sunder_align64(offset, struct_alignment);
+	SUNDER_LOG("\naligned offset: ");
+	SUNDER_LOG(aligned_offset);
+	bytes_of_padding = aligned_offset - offset;
+	SUNDER_LOG("\nbytes of padding added: ");
+	SUNDER_LOG(bytes_of_padding);
+	offset = aligned_offset;
+	SUNDER_LOG("\npost allocation offset: ");
+	SUNDER_LOG(offset);
+	SUNDER_LOG("\n");
+
+	return offset;
+}
+
+u64 sunder_get_aligned_struct_allocation_size(const u64* alignment_buffer, const u64* allocation_size_buffer, u64 buffer_size, u64 struct_alignment)
+{
+	u64 offset = 0;
+	u64 aligned_offset = 0;
+	u64 bytes_of_padding = 0;
+
+	for (u64 i = 0; i < buffer_size; i++)
+	{
+		aligned_offset = sunder_align64(offset, alignment_buffer[i]);
+		bytes_of_padding = aligned_offset - offset;
+		offset = aligned_offset + allocation_size_buffer[i];
+	}
+
+	aligned_offset = sunder_align64(offset, struct_alignment);
+	bytes_of_padding = aligned_offset - offset;
+	offset = aligned_offset;
+
+	return offset;
+}
+
+u64 sunder_initialize_buffer(void* buffer, u64 buffer_size, u64 starting_offset, u64 bytes_to_init)
+{
+	const u8 zero = 0;
+
+	return sunder_fill_buffer(buffer, buffer_size, starting_offset, bytes_to_init, &zero, 1);
+}
+
+u64 sunder_fill_buffer(void* buffer, u64 buffer_size, u64 starting_offset, u64 bytes_to_fill, const void* pattern, u32 pattern_size)
 {
-	return sunder_suballocate_from_arena_internal(arena, bytes, alignment);
+	if (buffer == nullptr || pattern == nullptr) { return 0; }
+	if (starting_offset > buffer_size) { return 0; }
+	if (starting_offset + bytes_to_fill > buffer_size) { return 0; }
+	if (pattern_size == 0 || pattern_size > 16 || !sunder_is_power_of_2(pattern_size)) { return 0; }
+
+	sunder_fill_bytes_internal((u8*)buffer + starting_offset, bytes_to_fill, (const u8*)pattern, pattern_size);
+
+	return bytes_to_fill;
 }
 
-sunder_arena_suballocation_result_t sunder_suballocate_from_arena_debug(sunder_arena_t* arena, u64 bytes, u32 alignment)
+u64 sunder_compute_aligned_allocation_size(u64 type_size_in_bytes, u64 element_count, u64 alignment)
 {
-	return sunder_suballocate_from_arena_debug_internal(arena, bytes, alignment);
+	return sunder_align64(sunder_compute_array_size_in_bytes(type_size_in_bytes, element_count), alignment);
+}
+
+
+u8 sunder_to_bit_mask8(const sunder_bit_index_buffer8_t& storage, u32 count)
+{
+	u8 mask = 0;
+	u8 merged_count = 0;
+	const u16 bit_count = sizeof(u8) * 8;
+
+	SUNDER_TO_BIT_MASK(u8, 1, mask, storage, count, merged_count, bit_count);
+	if (mask == 0) { return UINT8_MAX; }
+	if (merged_count != count) { return UINT8_MAX; }
+
+	return mask;
+}
+
+u16 sunder_to_bit_mask16(const sunder_bit_index_buffer16_t& storage, u32 count)
+{
+	u16 mask = 0;
+	u16 merged_count = 0;
+	const u16 bit_count = sizeof(u16) * 8;
+
+	SUNDER_TO_BIT_MASK(u16, 1, mask, storage, count, merged_count, bit_count);
+	if (mask == 0) { return UINT16_MAX; }
+	if (merged_count != count) { return UINT16_MAX; }
+
+	return mask;
+}
+
+u32 sunder_to_bit_mask32(const sunder_bit_index_buffer32_t& storage, u32 count)
+{
+	u32 mask = 0;
+	u32 merged_count = 0;
+	const u16 bit_count = sizeof(u32) * 8;
+
+	SUNDER_TO_BIT_MASK(u32, 1U, mask, storage, count, merged_count, bit_count);
+	if (mask == 0) { return UINT32_MAX; }
+	if (merged_count != count) { return UINT32_MAX; }
+
+	return mask;
+}
+
+u64 sunder_to_bit_mask64(const sunder_bit_index_buffer64_t& storage, u32 count)
+{
+	u64 mask = 0;
+	u64 merged_count = 0;
+	const u16 bit_count = sizeof(u64) * 8;
+
+	SUNDER_TO_BIT_MASK(u64, 1ULL, mask, storage, count, merged_count, bit_count);
+	if (mask == 0) { return UINT64_MAX; }
+	if (merged_count != count) { return UINT64_MAX; }
+
+	return mask;
+}
+
+enum sunder_search_mode : u32
+{
+	SUNDER_SEARCH_MODE_FIND_FIRST = 0u,
+	SUNDER_SEARCH_MODE_FIND_FIRST_NOT = 1u,
+	SUNDER_SEARCH_MODE_COUNT = 2u,
+	SUNDER_SEARCH_MODE_FIND_ALL = 3u
+};
+
+struct sunder_search_state_t
+{
+	u64 result = SUNDER_SEARCH_NOT_FOUND;
+	u64 count = 0;
+	u64* indices = nullptr;
+	u64 index_capacity = 0;
+};
+
+SUNDER_INTERNAL u32 sunder_count_trailing_zeros_u64_internal(u64 val)
+{
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward64(&index, val);
+	return (u32)index;
+#else
+	return (u32)__builtin_ctzll(val);
+#endif
+}
+
+SUNDER_INTERNAL u32 sunder_count_set_bits_u64_internal(u64 val)
+{
+#if defined(_MSC_VER)
+	// __popcnt64 needs the popcnt instruction which is not guaranteed on sse2 only machines
+	val = val - ((val >> 1) & 0x5555555555555555ull);
+	val = (val & 0x3333333333333333ull) + ((val >> 2) & 0x3333333333333333ull);
+	val = (val + (val >> 4)) & 0x0f0f0f0f0f0f0f0full;
+	return (u32)((val * 0x0101010101010101ull) >> 56);
+#else
+	return (u32)__builtin_popcountll(val);
+#endif
+}
+
+// bit k of mask is set when byte k of the 64 byte block at element block_begin compared equal, every element sets all of its sizeof(type) bits together
+template<typename type, u32 mode>
+SUNDER_INTERNAL inline bool sunder_consume_search_mask_internal(u64 mask, u64 block_begin, sunder_search_state_t* state)
+{
+	if (mode == SUNDER_SEARCH_MODE_FIND_FIRST_NOT) { mask = ~mask; }
+
+	if (mode == SUNDER_SEARCH_MODE_FIND_FIRST || mode == SUNDER_SEARCH_MODE_FIND_FIRST_NOT)
+	{
+		if (mask == 0) { return false; }
+
+		state->result = block_begin + sunder_count_trailing_zeros_u64_internal(mask) / sizeof(type);
+		return true;
+	}
+
+	if (mode == SUNDER_SEARCH_MODE_COUNT)
+	{
+		state->count += sunder_count_set_bits_u64_internal(mask) / sizeof(type);
+		return false;
+	}
+
+	const u64 element_mask = (1ull << sizeof(type)) - 1;
+
+	while (mask != 0)
+	{
+		const u32 bit = sunder_count_trailing_zeros_u64_internal(mask);
+		if (state->count < state->index_capacity) { state->indices[state->count] = block_begin + bit / sizeof(type); }
+
+		state->count++;
+		mask &= ~(element_mask << bit);
+	}
+
+	return false;
+}
+
+template<typename type, u32 mode>
+SUNDER_INTERNAL bool sunder_search_scalar_internal(const type* buffer, u64 starting_index, u64 ending_index, type val, sunder_search_state_t* state)
+{
+	for (u64 i = starting_index; i < ending_index; i++)
+	{
+		const bool equal = buffer[i] == val;
+
+		if (mode == SUNDER_SEARCH_MODE_FIND_FIRST && equal) { state->result = i; return true; }
+		if (mode == SUNDER_SEARCH_MODE_FIND_FIRST_NOT && !equal) { state->result = i; return true; }
+
+		if (mode == SUNDER_SEARCH_MODE_COUNT && equal) { state->count++; }
+
+		if (mode == SUNDER_SEARCH_MODE_FIND_ALL && equal)
+		{
+			if (state->count < state->index_capacity) { state->indices[state->count] = i; }
+			state->count++;
+		}
+	}
+
+	return false;
+}
+
+#if defined(SUNDER_X86)
+// broadcast + per byte equality mask of one vector for every searchable type
+template<typename type> struct sunder_search_vector_t;
+
+template<> struct sunder_search_vector_t<u8>
+{
+	static __m128i broadcast_sse2(u8 val) { return _mm_set1_epi8((char)val); }
+	static u32 equal_mask_sse2(const u8* data, __m128i val) { return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)data), val)); }
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u8 val) { return _mm256_set1_epi8((char)val); }
+	SUNDER_TARGET_AVX2 static u32 equal_mask_avx2(const u8* data, __m256i val) { return (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)data), val)); }
+};
+
+template<> struct sunder_search_vector_t<u16>
+{
+	static __m128i broadcast_sse2(u16 val) { return _mm_set1_epi16((short)val); }
+	static u32 equal_mask_sse2(const u16* data, __m128i val) { return (u32)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)data), val)); }
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u16 val) { return _mm256_set1_epi16((short)val); }
+	SUNDER_TARGET_AVX2 static u32 equal_mask_avx2(const u16* data, __m256i val) { return (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)data), val)); }
+};
+
+template<> struct sunder_search_vector_t<u32>
+{
+	static __m128i broadcast_sse2(u32 val) { return _mm_set1_epi32((int)val); }
+	static u32 equal_mask_sse2(const u32* data, __m128i val) { return (u32)_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)data), val)); }
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u32 val) { return _mm256_set1_epi32((int)val); }
+	SUNDER_TARGET_AVX2 static u32 equal_mask_avx2(const u32* data, __m256i val) { return (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)data), val)); }
+};
+
+template<> struct sunder_search_vector_t<u64>
+{
+	static __m128i broadcast_sse2(u64 val) { return _mm_set1_epi64x((long long)val); }
+
+	static u32 equal_mask_sse2(const u64* data, __m128i val)
+	{
+		// no 64 bit compare before sse4.1, both 32 bit halves have to match
+		const __m128i halves = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)data), val);
+		return (u32)_mm_movemask_epi8(_mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1))));
+	}
+
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u64 val) { return _mm256_set1_epi64x((long long)val); }
+	SUNDER_TARGET_AVX2 static u32 equal_mask_avx2(const u64* data, __m256i val) { return (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)data), val)); }
+};
+
+template<> struct sunder_search_vector_t<f32>
+{
+	static __m128 broadcast_sse2(f32 val) { return _mm_set1_ps(val); }
+	static u32 equal_mask_sse2(const f32* data, __m128 val) { return (u32)_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(data), val))); }
+	SUNDER_TARGET_AVX2 static __m256 broadcast_avx2(f32 val) { return _mm256_set1_ps(val); }
+	SUNDER_TARGET_AVX2 static u32 equal_mask_avx2(const f32* data, __m256 val) { return (u32)_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(data), val, _CMP_EQ_OQ))); }
+};
+
+template<> struct sunder_search_vector_t<f64>
+{
+	static __m128d broadcast_sse2(f64 val) { return _mm_set1_pd(val); }
+	static u32 equal_mask_sse2(const f64* data, __m128d val) { return (u32)_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(data), val))); }
+	SUNDER_TARGET_AVX2 static __m256d broadcast_avx2(f64 val) { return _mm256_set1_pd(val); }
+	SUNDER_TARGET_AVX2 static u32 equal_mask_avx2(const f64* data, __m256d val) { return (u32)_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(data), val, _CMP_EQ_OQ))); }
+};
+
+// 64 bytes (four vectors) per iteration, whatever is left is searched by the scalar loop
+template<typename type, u32 mode>
+SUNDER_INTERNAL bool sunder_search_sse2_internal(const type* buffer, u64 starting_index, u64 ending_index, type val, sunder_search_state_t* state)
+{
+	typedef sunder_search_vector_t<type> vector;
+
+	const auto broadcast = vector::broadcast_sse2(val);
+	const u64 block_elements = 64 / sizeof(type);
+	const u64 vector_elements = 16 / sizeof(type);
+	u64 i = starting_index;
+
+	for (; i + block_elements <= ending_index; i += block_elements)
+	{
+		const u64 mask0 = vector::equal_mask_sse2(buffer + i, broadcast);
+		const u64 mask1 = vector::equal_mask_sse2(buffer + i + vector_elements, broadcast);
+		const u64 mask2 = vector::equal_mask_sse2(buffer + i + vector_elements * 2, broadcast);
+		const u64 mask3 = vector::equal_mask_sse2(buffer + i + vector_elements * 3, broadcast);
+
+		if (sunder_consume_search_mask_internal<type, mode>(mask0 | (mask1 << 16) | (mask2 << 32) | (mask3 << 48), i, state)) { return true; }
+	}
+
+	return sunder_search_scalar_internal<type, mode>(buffer, i, ending_index, val, state);
+}
+
+// 128 bytes (four vectors) per iteration, consumed as two 64 bit masks
+template<typename type, u32 mode>
+SUNDER_TARGET_AVX2 SUNDER_INTERNAL bool sunder_search_avx2_internal(const type* buffer, u64 starting_index, u64 ending_index, type val, sunder_search_state_t* state)
+{
+	typedef sunder_search_vector_t<type> vector;
+
+	const auto broadcast = vector::broadcast_avx2(val);
+	const u64 block_elements = 64 / sizeof(type);
+	const u64 vector_elements = 32 / sizeof(type);
+	u64 i = starting_index;
+
+	for (; i + block_elements * 2 <= ending_index; i += block_elements * 2)
+	{
+		const u64 mask0 = vector::equal_mask_avx2(buffer + i, broadcast);
+		const u64 mask1 = vector::equal_mask_avx2(buffer + i + vector_elements, broadcast);
+		const u64 mask2 = vector::equal_mask_avx2(buffer + i + vector_elements * 2, broadcast);
+		const u64 mask3 = vector::equal_mask_avx2(buffer + i + vector_elements * 3, broadcast);
+
+		if (sunder_consume_search_mask_internal<type, mode>(mask0 | (mask1 << 32), i, state)) { _mm256_zeroupper(); return true; }
+		if (sunder_consume_search_mask_internal<type, mode>(mask2 | (mask3 << 32), i + block_elements, state)) { _mm256_zeroupper(); return true; }
+	}
+
+	_mm256_zeroupper();
+
+	return sunder_search_sse2_internal<type, mode>(buffer, i, ending_index, val, state);
+}
+#endif
+
+template<typename type, u32 mode>
+SUNDER_INTERNAL sunder_search_state_t sunder_search_internal(const type* buffer, u64 starting_index, u64 ending_index, type val, u64* indices, u64 index_capacity)
+{
+	sunder_search_state_t state;
+	state.indices = indices;
+	state.index_capacity = indices != nullptr ? index_capacity : 0;
+
+	if (buffer == nullptr || starting_index >= ending_index) { return state; }
+
+#if defined(SUNDER_X86)
+	if (sunder_cpu_features.avx2 && (ending_index - starting_index) * sizeof(type) >= 128) { sunder_search_avx2_internal<type, mode>(buffer, starting_index, ending_index, val, &state); }
+	else { sunder_search_sse2_internal<type, mode>(buffer, starting_index, ending_index, val, &state); }
+#else
+	sunder_search_scalar_internal<type, mode>(buffer, starting_index, ending_index, val, &state);
+#endif
+
+	return state;
+}
+
+#define SUNDER_IMPLEMENT_SEARCH_FUNCTIONS(type, type_name) \
+			u64 sunder_find_first_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val) \
+			{ \
+				return sunder_search_internal<type, SUNDER_SEARCH_MODE_FIND_FIRST>(buffer, starting_index, ending_index, val, nullptr, 0).result; \
+			} \
+			\
+			u64 sunder_find_first_not_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val) \
+			{ \
+				return sunder_search_internal<type, SUNDER_SEARCH_MODE_FIND_FIRST_NOT>(buffer, starting_index, ending_index, val, nullptr, 0).result; \
+			} \
+			\
+			u64 sunder_count_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val) \
+			{ \
+				return sunder_search_internal<type, SUNDER_SEARCH_MODE_COUNT>(buffer, starting_index, ending_index, val, nullptr, 0).count; \
+			} \
+			\
+			u64 sunder_find_all_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val, u64* indices, u64 index_capacity) \
+			{ \
+				return sunder_search_internal<type, SUNDER_SEARCH_MODE_FIND_ALL>(buffer, starting_index, ending_index, val, indices, index_capacity).count; \
+			}
+
+SUNDER_IMPLEMENT_SEARCH_FUNCTIONS(u8, u8)
+SUNDER_IMPLEMENT_SEARCH_FUNCTIONS(u16, u16)
+SUNDER_IMPLEMENT_SEARCH_FUNCTIONS(u32, u32)
+SUNDER_IMPLEMENT_SEARCH_FUNCTIONS(u64, u64)
+SUNDER_IMPLEMENT_SEARCH_FUNCTIONS(f32, f32)
+SUNDER_IMPLEMENT_SEARCH_FUNCTIONS(f64, f64)
+
+bool sunder_exists_u32(const u32* buffer, u32 buffer_size, u32 val)
+{
+	return sunder_find_first_u32(buffer, 0, buffer_size, val) != SUNDER_SEARCH_NOT_FOUND;
+}
+
+template<typename type, u32 predicate>
+SUNDER_INTERNAL inline bool sunder_evaluate_filter_predicate_internal(type val, type operand, type sentinel)
+{
+	if (val == sentinel) { return false; }
+
+	switch (predicate)
+	{
+		case SUNDER_FILTER_PREDICATE_LESS: return val < operand;
+		case SUNDER_FILTER_PREDICATE_LESS_EQUAL: return val <= operand;
+		case SUNDER_FILTER_PREDICATE_EQUAL: return val == operand;
+		case SUNDER_FILTER_PREDICATE_NOT_EQUAL: return val != operand;
+		case SUNDER_FILTER_PREDICATE_GREATER: return val > operand;
+		case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: return val >= operand;
+		default: return false;
+	}
+}
+
+// same byte mask layout as the search kernels, every passing element is appended to indices or values
+template<typename type, bool write_values>
+SUNDER_INTERNAL inline u64 sunder_emit_filter_mask_internal(u64 mask, const type* buffer, u64 block_begin, u64* indices, type* values, u64 count)
+{
+	const u64 element_mask = (1ull << sizeof(type)) - 1;
+
+	while (mask != 0)
+	{
+		const u32 bit = sunder_count_trailing_zeros_u64_internal(mask);
+		const u64 index = block_begin + bit / sizeof(type);
+
+		if (write_values) { values[count] = buffer[index]; }
+		else { indices[count] = index; }
+
+		count++;
+		mask &= ~(element_mask << bit);
+	}
+
+	return count;
+}
+
+template<typename type, u32 predicate, bool write_values>
+SUNDER_INTERNAL u64 sunder_filter_scalar_internal(const type* buffer, u64 starting_index, u64 ending_index, type operand, type sentinel, u64* indices, type* values, u64 count)
+{
+	for (u64 i = starting_index; i < ending_index; i++)
+	{
+		if (!sunder_evaluate_filter_predicate_internal<type, predicate>(buffer[i], operand, sentinel)) { continue; }
+
+		if (write_values) { values[count] = buffer[i]; }
+		else { indices[count] = i; }
+
+		count++;
+	}
+
+	return count;
+}
+
+#if defined(SUNDER_X86)
+// integer lanes are compared signed, unsigned operands get their sign bit flipped first so the ordering is preserved
+SUNDER_INTERNAL inline __m128i sunder_select_filter_predicate_sse2_internal(u32 predicate, __m128i less, __m128i greater, __m128i equal)
+{
+	const __m128i ones = _mm_set1_epi32(-1);
+
+	switch (predicate)
+	{
+		case SUNDER_FILTER_PREDICATE_LESS: return less;
+		case SUNDER_FILTER_PREDICATE_LESS_EQUAL: return _mm_andnot_si128(greater, ones);
+		case SUNDER_FILTER_PREDICATE_EQUAL: return equal;
+		case SUNDER_FILTER_PREDICATE_NOT_EQUAL: return _mm_andnot_si128(equal, ones);
+		case SUNDER_FILTER_PREDICATE_GREATER: return greater;
+		case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: return _mm_andnot_si128(less, ones);
+		default: return _mm_setzero_si128();
+	}
+}
+
+SUNDER_TARGET_AVX2 SUNDER_INTERNAL inline __m256i sunder_select_filter_predicate_avx2_internal(u32 predicate, __m256i less, __m256i greater, __m256i equal)
+{
+	const __m256i ones = _mm256_set1_epi32(-1);
+
+	switch (predicate)
+	{
+		case SUNDER_FILTER_PREDICATE_LESS: return less;
+		case SUNDER_FILTER_PREDICATE_LESS_EQUAL: return _mm256_andnot_si256(greater, ones);
+		case SUNDER_FILTER_PREDICATE_EQUAL: return equal;
+		case SUNDER_FILTER_PREDICATE_NOT_EQUAL: return _mm256_andnot_si256(equal, ones);
+		case SUNDER_FILTER_PREDICATE_GREATER: return greater;
+		case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: return _mm256_andnot_si256(less, ones);
+		default: return _mm256_setzero_si256();
+	}
+}
+
+// broadcast + per byte predicate mask (with the sentinel already excluded) of one vector for every filterable type
+template<typename type> struct sunder_filter_vector_t;
+
+template<> struct sunder_filter_vector_t<u8>
+{
+	static __m128i broadcast_sse2(u8 val) { return _mm_set1_epi8((char)(val ^ 0x80u)); }
+
+	template<u32 predicate> static u32 predicate_mask_sse2(const u8* data, __m128i operand, __m128i sentinel)
+	{
+		const __m128i lanes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), _mm_set1_epi8((char)0x80u));
+		const __m128i passed = sunder_select_filter_predicate_sse2_internal(predicate, _mm_cmplt_epi8(lanes, operand), _mm_cmpgt_epi8(lanes, operand), _mm_cmpeq_epi8(lanes, operand));
+		return (u32)_mm_movemask_epi8(_mm_andnot_si128(_mm_cmpeq_epi8(lanes, sentinel), passed));
+	}
+
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u8 val) { return _mm256_set1_epi8((char)(val ^ 0x80u)); }
+
+	template<u32 predicate> SUNDER_TARGET_AVX2 static u32 predicate_mask_avx2(const u8* data, __m256i operand, __m256i sentinel)
+	{
+		const __m256i lanes = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)data), _mm256_set1_epi8((char)0x80u));
+		const __m256i passed = sunder_select_filter_predicate_avx2_internal(predicate, _mm256_cmpgt_epi8(operand, lanes), _mm256_cmpgt_epi8(lanes, operand), _mm256_cmpeq_epi8(lanes, operand));
+		return (u32)_mm256_movemask_epi8(_mm256_andnot_si256(_mm256_cmpeq_epi8(lanes, sentinel), passed));
+	}
+};
+
+template<> struct sunder_filter_vector_t<u16>
+{
+	static __m128i broadcast_sse2(u16 val) { return _mm_set1_epi16((short)(val ^ 0x8000u)); }
+
+	template<u32 predicate> static u32 predicate_mask_sse2(const u16* data, __m128i operand, __m128i sentinel)
+	{
+		const __m128i lanes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), _mm_set1_epi16((short)0x8000u));
+		const __m128i passed = sunder_select_filter_predicate_sse2_internal(predicate, _mm_cmplt_epi16(lanes, operand), _mm_cmpgt_epi16(lanes, operand), _mm_cmpeq_epi16(lanes, operand));
+		return (u32)_mm_movemask_epi8(_mm_andnot_si128(_mm_cmpeq_epi16(lanes, sentinel), passed));
+	}
+
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u16 val) { return _mm256_set1_epi16((short)(val ^ 0x8000u)); }
+
+	template<u32 predicate> SUNDER_TARGET_AVX2 static u32 predicate_mask_avx2(const u16* data, __m256i operand, __m256i sentinel)
+	{
+		const __m256i lanes = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)data), _mm256_set1_epi16((short)0x8000u));
+		const __m256i passed = sunder_select_filter_predicate_avx2_internal(predicate, _mm256_cmpgt_epi16(operand, lanes), _mm256_cmpgt_epi16(lanes, operand), _mm256_cmpeq_epi16(lanes, operand));
+		return (u32)_mm256_movemask_epi8(_mm256_andnot_si256(_mm256_cmpeq_epi16(lanes, sentinel), passed));
+	}
+};
+
+template<> struct sunder_filter_vector_t<u32>
+{
+	static __m128i broadcast_sse2(u32 val) { return _mm_set1_epi32((int)(val ^ 0x80000000u)); }
+
+	template<u32 predicate> static u32 predicate_mask_sse2(const u32* data, __m128i operand, __m128i sentinel)
+	{
+		const __m128i lanes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), _mm_set1_epi32((int)0x80000000u));
+		const __m128i passed = sunder_select_filter_predicate_sse2_internal(predicate, _mm_cmplt_epi32(lanes, operand), _mm_cmpgt_epi32(lanes, operand), _mm_cmpeq_epi32(lanes, operand));
+		return (u32)_mm_movemask_epi8(_mm_andnot_si128(_mm_cmpeq_epi32(lanes, sentinel), passed));
+	}
+
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u32 val) { return _mm256_set1_epi32((int)(val ^ 0x80000000u)); }
+
+	template<u32 predicate> SUNDER_TARGET_AVX2 static u32 predicate_mask_avx2(const u32* data, __m256i operand, __m256i sentinel)
+	{
+		const __m256i lanes = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)data), _mm256_set1_epi32((int)0x80000000u));
+		const __m256i passed = sunder_select_filter_predicate_avx2_internal(predicate, _mm256_cmpgt_epi32(operand, lanes), _mm256_cmpgt_epi32(lanes, operand), _mm256_cmpeq_epi32(lanes, operand));
+		return (u32)_mm256_movemask_epi8(_mm256_andnot_si256(_mm256_cmpeq_epi32(lanes, sentinel), passed));
+	}
+};
+
+template<> struct sunder_filter_vector_t<u64>
+{
+	// no 64 bit ordered compare before sse4.2, the two lanes are evaluated one by one
+	static u64 broadcast_sse2(u64 val) { return val; }
+
+	template<u32 predicate> static u32 predicate_mask_sse2(const u64* data, u64 operand, u64 sentinel)
+	{
+		const u32 lane0 = sunder_evaluate_filter_predicate_internal<u64, predicate>(data[0], operand, sentinel) ? 0x00ffu : 0u;
+		const u32 lane1 = sunder_evaluate_filter_predicate_internal<u64, predicate>(data[1], operand, sentinel) ? 0xff00u : 0u;
+		return lane0 | lane1;
+	}
+
+	SUNDER_TARGET_AVX2 static __m256i broadcast_avx2(u64 val) { return _mm256_set1_epi64x((long long)(val ^ 0x8000000000000000ull)); }
+
+	template<u32 predicate> SUNDER_TARGET_AVX2 static u32 predicate_mask_avx2(const u64* data, __m256i operand, __m256i sentinel)
+	{
+		const __m256i lanes = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)data), _mm256_set1_epi64x((long long)0x8000000000000000ull));
+		const __m256i passed = sunder_select_filter_predicate_avx2_internal(predicate, _mm256_cmpgt_epi64(operand, lanes), _mm256_cmpgt_epi64(lanes, operand), _mm256_cmpeq_epi64(lanes, operand));
+		return (u32)_mm256_movemask_epi8(_mm256_andnot_si256(_mm256_cmpeq_epi64(lanes, sentinel), passed));
+	}
+};
+
+// float compares are ordered (nan never passes) except for not equal, which matches the scalar operators
+template<> struct sunder_filter_vector_t<f32>
+{
+	static __m128 broadcast_sse2(f32 val) { return _mm_set1_ps(val); }
+
+	template<u32 predicate> static u32 predicate_mask_sse2(const f32* data, __m128 operand, __m128 sentinel)
+	{
+		const __m128 lanes = _mm_loadu_ps(data);
+		__m128 passed = _mm_setzero_ps();
+
+		switch (predicate)
+		{
+			case SUNDER_FILTER_PREDICATE_LESS: passed = _mm_cmplt_ps(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_LESS_EQUAL: passed = _mm_cmple_ps(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_EQUAL: passed = _mm_cmpeq_ps(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_NOT_EQUAL: passed = _mm_cmpneq_ps(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_GREATER: passed = _mm_cmpgt_ps(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: passed = _mm_cmpge_ps(lanes, operand); break;
+			default: break;
+		}
+
+		return (u32)_mm_movemask_epi8(_mm_castps_si128(_mm_andnot_ps(_mm_cmpeq_ps(lanes, sentinel), passed)));
+	}
+
+	SUNDER_TARGET_AVX2 static __m256 broadcast_avx2(f32 val) { return _mm256_set1_ps(val); }
+
+	template<u32 predicate> SUNDER_TARGET_AVX2 static u32 predicate_mask_avx2(const f32* data, __m256 operand, __m256 sentinel)
+	{
+		const __m256 lanes = _mm256_loadu_ps(data);
+		__m256 passed = _mm256_setzero_ps();
+
+		switch (predicate)
+		{
+			case SUNDER_FILTER_PREDICATE_LESS: passed = _mm256_cmp_ps(lanes, operand, _CMP_LT_OQ); break;
+			case SUNDER_FILTER_PREDICATE_LESS_EQUAL: passed = _mm256_cmp_ps(lanes, operand, _CMP_LE_OQ); break;
+			case SUNDER_FILTER_PREDICATE_EQUAL: passed = _mm256_cmp_ps(lanes, operand, _CMP_EQ_OQ); break;
+			case SUNDER_FILTER_PREDICATE_NOT_EQUAL: passed = _mm256_cmp_ps(lanes, operand, _CMP_NEQ_UQ); break;
+			case SUNDER_FILTER_PREDICATE_GREATER: passed = _mm256_cmp_ps(lanes, operand, _CMP_GT_OQ); break;
+			case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: passed = _mm256_cmp_ps(lanes, operand, _CMP_GE_OQ); break;
+			default: break;
+		}
+
+		return (u32)_mm256_movemask_epi8(_mm256_castps_si256(_mm256_andnot_ps(_mm256_cmp_ps(lanes, sentinel, _CMP_EQ_OQ), passed)));
+	}
+};
+
+template<> struct sunder_filter_vector_t<f64>
+{
+	static __m128d broadcast_sse2(f64 val) { return _mm_set1_pd(val); }
+
+	template<u32 predicate> static u32 predicate_mask_sse2(const f64* data, __m128d operand, __m128d sentinel)
+	{
+		const __m128d lanes = _mm_loadu_pd(data);
+		__m128d passed = _mm_setzero_pd();
+
+		switch (predicate)
+		{
+			case SUNDER_FILTER_PREDICATE_LESS: passed = _mm_cmplt_pd(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_LESS_EQUAL: passed = _mm_cmple_pd(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_EQUAL: passed = _mm_cmpeq_pd(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_NOT_EQUAL: passed = _mm_cmpneq_pd(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_GREATER: passed = _mm_cmpgt_pd(lanes, operand); break;
+			case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: passed = _mm_cmpge_pd(lanes, operand); break;
+			default: break;
+		}
+
+		return (u32)_mm_movemask_epi8(_mm_castpd_si128(_mm_andnot_pd(_mm_cmpeq_pd(lanes, sentinel), passed)));
+	}
+
+	SUNDER_TARGET_AVX2 static __m256d broadcast_avx2(f64 val) { return _mm256_set1_pd(val); }
+
+	template<u32 predicate> SUNDER_TARGET_AVX2 static u32 predicate_mask_avx2(const f64* data, __m256d operand, __m256d sentinel)
+	{
+		const __m256d lanes = _mm256_loadu_pd(data);
+		__m256d passed = _mm256_setzero_pd();
+
+		switch (predicate)
+		{
+			case SUNDER_FILTER_PREDICATE_LESS: passed = _mm256_cmp_pd(lanes, operand, _CMP_LT_OQ); break;
+			case SUNDER_FILTER_PREDICATE_LESS_EQUAL: passed = _mm256_cmp_pd(lanes, operand, _CMP_LE_OQ); break;
+			case SUNDER_FILTER_PREDICATE_EQUAL: passed = _mm256_cmp_pd(lanes, operand, _CMP_EQ_OQ); break;
+			case SUNDER_FILTER_PREDICATE_NOT_EQUAL: passed = _mm256_cmp_pd(lanes, operand, _CMP_NEQ_UQ); break;
+			case SUNDER_FILTER_PREDICATE_GREATER: passed = _mm256_cmp_pd(lanes, operand, _CMP_GT_OQ); break;
+			case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: passed = _mm256_cmp_pd(lanes, operand, _CMP_GE_OQ); break;
+			default: break;
+		}
+
+		return (u32)_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_andnot_pd(_mm256_cmp_pd(lanes, sentinel, _CMP_EQ_OQ), passed)));
+	}
+};
+
+// 64 bytes (four vectors) per iteration, blocks where nothing passed cost a single branch
+template<typename type, u32 predicate, bool write_values>
+SUNDER_INTERNAL u64 sunder_filter_sse2_internal(const type* buffer, u64 starting_index, u64 ending_index, type operand, type sentinel, u64* indices, type* values, u64 count)
+{
+	typedef sunder_filter_vector_t<type> vector;
+
+	const auto operand_broadcast = vector::broadcast_sse2(operand);
+	const auto sentinel_broadcast = vector::broadcast_sse2(sentinel);
+	const u64 block_elements = 64 / sizeof(type);
+	const u64 vector_elements = 16 / sizeof(type);
+	u64 i = starting_index;
+
+	for (; i + block_elements <= ending_index; i += block_elements)
+	{
+		const u64 mask0 = vector::template predicate_mask_sse2<predicate>(buffer + i, operand_broadcast, sentinel_broadcast);
+		const u64 mask1 = vector::template predicate_mask_sse2<predicate>(buffer + i + vector_elements, operand_broadcast, sentinel_broadcast);
+		const u64 mask2 = vector::template predicate_mask_sse2<predicate>(buffer + i + vector_elements * 2, operand_broadcast, sentinel_broadcast);
+		const u64 mask3 = vector::template predicate_mask_sse2<predicate>(buffer + i + vector_elements * 3, operand_broadcast, sentinel_broadcast);
+
+		count = sunder_emit_filter_mask_internal<type, write_values>(mask0 | (mask1 << 16) | (mask2 << 32) | (mask3 << 48), buffer, i, indices, values, count);
+	}
+
+	return sunder_filter_scalar_internal<type, predicate, write_values>(buffer, i, ending_index, operand, sentinel, indices, values, count);
 }
 
-sunder_arena_result sunder_free_arena(sunder_arena_t* arena)
+// 128 bytes (four vectors) per iteration, emitted as two 64 bit masks
+template<typename type, u32 predicate, bool write_values>
+SUNDER_TARGET_AVX2 SUNDER_INTERNAL u64 sunder_filter_avx2_internal(const type* buffer, u64 starting_index, u64 ending_index, type operand, type sentinel, u64* indices, type* values, u64 count)
 {
-	if (arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
-	if (arena->buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	typedef sunder_filter_vector_t<type> vector;
 
-	arena->offset = 0;
-	arena->capacity = 0;
+	const auto operand_broadcast = vector::broadcast_avx2(operand);
+	const auto sentinel_broadcast = vector::broadcast_avx2(sentinel);
+	const u64 block_elements = 64 / sizeof(type);
+	const u64 vector_elements = 32 / sizeof(type);
+	u64 i = starting_index;
+
+	for (; i + block_elements * 2 <= ending_index; i += block_elements * 2)
+	{
+		const u64 mask0 = vector::template predicate_mask_avx2<predicate>(buffer + i, operand_broadcast, sentinel_broadcast);
+		const u64 mask1 = vector::template predicate_mask_avx2<predicate>(buffer + i + vector_elements, operand_broadcast, sentinel_broadcast);
+		const u64 mask2 = vector::template predicate_mask_avx2<predicate>(buffer + i + vector_elements * 2, operand_broadcast, sentinel_broadcast);
+		const u64 mask3 = vector::template predicate_mask_avx2<predicate>(buffer + i + vector_elements * 3, operand_broadcast, sentinel_broadcast);
 
-	// later account for chained arena specification
+		count = sunder_emit_filter_mask_internal<type, write_values>(mask0 | (mask1 << 32), buffer, i, indices, values, count);
+		count = sunder_emit_filter_mask_internal<type, write_values>(mask2 | (mask3 << 32), buffer, i + block_elements, indices, values, count);
+	}
 
-	sunder_aligned_free((void**)&arena->buffer);
+	_mm256_zeroupper();
 
-	return SUNDER_ARENA_RESULT_SUCCESS;
+	return sunder_filter_sse2_internal<type, predicate, write_values>(buffer, i, ending_index, operand, sentinel, indices, values, count);
 }
+#endif
 
-u64 sunder_get_aligned_struct_allocation_size_debug(const u64* alignment_buffer, const u64* allocation_size_buffer, u64 buffer_size, u64 struct_alignment)
+template<typename type, u32 predicate, bool write_values>
+SUNDER_INTERNAL u64 sunder_filter_dispatch_internal(const type* buffer, u64 starting_index, u64 ending_index, type operand, type sentinel, u64* indices, type* values)
 {
-	u64 offset = 0;
-	u64 aligned_offset = 0;
-	u64 bytes_of_padding = 0;
+#if defined(SUNDER_X86)
+	if (sunder_cpu_features.avx2 && (ending_index - starting_index) * sizeof(type) >= 128) { return sunder_filter_avx2_internal<type, predicate, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values, 0); }
+	return sunder_filter_sse2_internal<type, predicate, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values, 0);
+#else
+	return sunder_filter_scalar_internal<type, predicate, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values, 0);
+#endif
+}
 
-	for (u64 i = 0; i < buffer_size; i++)
+// output is written from its first entry on, indices stay absolute
+template<typename type, bool write_values>
+SUNDER_INTERNAL u64 sunder_filter_internal(const type* buffer, u64 starting_index, u64 ending_index, u32 predicate, type operand, type sentinel, u64* indices, type* values)
+{
+	switch (predicate)
 	{
-		SUNDER_LOG("\nrequested alignment: ");
-		SUNDER_LOG(alignment_buffer[i]);
-		aligned_offset = sunder_align64(offset, alignment_buffer[i]);
-		SUNDER_LOG("\nallocating ");
-		SUNDER_LOG(allocation_size_buffer[i]);
-		SUNDER_LOG(" bytes");
-		SUNDER_LOG("\ncurrent offset: ");
-		SUNDER_LOG(offset);
-		SUNDER_LOG("\naligned offset: ");
-		SUNDER_LOG(aligned_offset);
-		bytes_of_padding = aligned_offset - offset;
-		SUNDER_LOG("\nbytes of padding added: ");
-		SUNDER_LOG(bytes_of_padding);
-		offset = aligned_offset + allocation_size_buffer[i];
-		SUNDER_LOG("\npost allocation offset: ");
-		SUNDER_LOG(offset);
-		SUNDER_LOG("\n");
+		case SUNDER_FILTER_PREDICATE_LESS: return sunder_filter_dispatch_internal<type, SUNDER_FILTER_PREDICATE_LESS, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values);
+		case SUNDER_FILTER_PREDICATE_LESS_EQUAL: return sunder_filter_dispatch_internal<type, SUNDER_FILTER_PREDICATE_LESS_EQUAL, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values);
+		case SUNDER_FILTER_PREDICATE_EQUAL: return sunder_filter_dispatch_internal<type, SUNDER_FILTER_PREDICATE_EQUAL, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values);
+		case SUNDER_FILTER_PREDICATE_NOT_EQUAL: return sunder_filter_dispatch_internal<type, SUNDER_FILTER_PREDICATE_NOT_EQUAL, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values);
+		case SUNDER_FILTER_PREDICATE_GREATER: return sunder_filter_dispatch_internal<type, SUNDER_FILTER_PREDICATE_GREATER, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values);
+		case SUNDER_FILTER_PREDICATE_GREATER_EQUAL: return sunder_filter_dispatch_internal<type, SUNDER_FILTER_PREDICATE_GREATER_EQUAL, write_values>(buffer, starting_index, ending_index, operand, sentinel, indices, values);
+		default: return 0;
 	}
+}
 
-	SUNDER_LOG("\nrequested alignment: ");
-	SUNDER_LOG(struct_alignment);
-	SUNDER_LOG("\nallocating ");
-	SUNDER_LOG(0);
-	SUNDER_LOG(" bytes");
-	SUNDER_LOG("\ncurrent offset: ");
-	SUNDER_LOG(offset);
-	aligned_offset = sunder_align64(offset, struct_alignment);
-	SUNDER_LOG("\naligned offset: ");
-	SUNDER_LOG(aligned_offset);
-	bytes_of_padding = aligned_offset - offset;
-	SUNDER_LOG("\nbytes of padding added: ");
-	SUNDER_LOG(bytes_of_padding);
-	offset = aligned_offset;
-	SUNDER_LOG("\npost allocation offset: ");
-	SUNDER_LOG(offset);
-	SUNDER_LOG("\n");
+template<typename type>
+struct sunder_filter_job_t
+{
+	const type* buffer = nullptr;
+	u64 starting_index = 0;
+	u64 ending_index = 0;
+	u32 predicate = 0;
+	type operand = 0;
+	type sentinel = 0;
+	u64* indices = nullptr;
+	type* values = nullptr;
+	u64 count = 0;
+};
+
+template<typename type>
+SUNDER_INTERNAL void sunder_run_filter_job_internal(void* args)
+{
+	sunder_filter_job_t<type>* job = (sunder_filter_job_t<type>*)args;
 
-	return offset;
+	if (job->values != nullptr) { job->count = sunder_filter_internal<type, true>(job->buffer, job->starting_index, job->ending_index, job->predicate, job->operand, job->sentinel, nullptr, job->values); }
+	else { job->count = sunder_filter_internal<type, false>(job->buffer, job->starting_index, job->ending_index, job->predicate, job->operand, job->sentinel, job->indices, nullptr); }
 }
 
-u64 sunder_get_aligned_struct_allocation_size(const u64* alignment_buffer, const u64* allocation_size_buffer, u64 buffer_size, u64 struct_alignment)
+// every job filters its chunk into the same range of the output, the gaps between the chunks are closed front to back afterwards
+template<typename type>
+SUNDER_INTERNAL u64 sunder_filter_parallel_internal(const type* buffer, u64 element_count, u32 predicate, type operand, type sentinel, u64* indices, type* values, u32 thread_count)
 {
-	u64 offset = 0;
-	u64 aligned_offset = 0;
-	u64 bytes_of_padding = 0;
+	u32 worker_count = thread_count < SUNDER_FILTER_MAX_THREAD_COUNT ? thread_count : SUNDER_FILTER_MAX_THREAD_COUNT;
+	if (worker_count > element_count / SUNDER_FILTER_MIN_ELEMENTS_PER_THREAD) { worker_count = (u32)(element_count / SUNDER_FILTER_MIN_ELEMENTS_PER_THREAD); }
+	if (worker_count == 0) { worker_count = 1; }
 
-	for (u64 i = 0; i < buffer_size; i++)
+	sunder_filter_job_t<type> jobs[SUNDER_FILTER_MAX_THREAD_COUNT];
+	const u64 chunk_elements = element_count / worker_count;
+
+	for (u32 i = 0; i < worker_count; i++)
 	{
-		aligned_offset = sunder_align64(offset, alignment_buffer[i]);
-		bytes_of_padding = aligned_offset - offset;
-		offset = aligned_offset + allocation_size_buffer[i];
+		sunder_filter_job_t<type>* job = &jobs[i];
+		job->buffer = buffer;
+		job->starting_index = chunk_elements * i;
+		job->ending_index = i + 1 == worker_count ? element_count : chunk_elements * (i + 1);
+		job->predicate = predicate;
+		job->operand = operand;
+		job->sentinel = sentinel;
+		job->indices = indices != nullptr ? indices + job->starting_index : nullptr;
+		job->values = values != nullptr ? values + job->starting_index : nullptr;
 	}
 
-	aligned_offset = sunder_align64(offset, struct_alignment);
-	bytes_of_padding = aligned_offset - offset;
-	offset = aligned_offset;
+	sunder_thread_t workers[SUNDER_FILTER_MAX_THREAD_COUNT];
 
-	return offset;
-}
+	for (u32 i = 1; i < worker_count; i++)
+	{
+		sunder_launch_thread(&workers[i], sunder_run_filter_job_internal<type>, &jobs[i]);
+	}
 
-u64 sunder_initialize_buffer(void* buffer, u64 buffer_size, u64 starting_offset, u64 bytes_to_init)
-{
-	if (buffer == nullptr) { return 0; }
-	if (starting_offset + bytes_to_init > buffer_size) { return 0; }
-	if (starting_offset > buffer_size) { return 0; }
+	sunder_run_filter_job_internal<type>(&jobs[0]);
+
+	for (u32 i = 1; i < worker_count; i++)
+	{
+		sunder_join_thread(&workers[i]);
+	}
 
-	i8* temp_ram_buffer_ptr = (i8*)buffer;
+	u64 count = jobs[0].count;
 
-	for (u64 i  = starting_offset; i < bytes_to_init; i++)
+	for (u32 i = 1; i < worker_count; i++)
 	{
-		temp_ram_buffer_ptr[i] = 0;
+		if (values != nullptr) { sunder_copy_bytes_internal((u8*)(values + count), (const u8*)jobs[i].values, jobs[i].count * sizeof(type)); }
+		else { sunder_copy_bytes_internal((u8*)(indices + count), (const u8*)jobs[i].indices, jobs[i].count * sizeof(u64)); }
+
+		count += jobs[i].count;
 	}
 
-	return bytes_to_init - starting_offset;
+	return count;
 }
 
-u64 sunder_compute_aligned_allocation_size(u64 type_size_in_bytes, u64 element_count, u64 alignment)
+#define SUNDER_IMPLEMENT_FILTER_FUNCTIONS(type, type_name) \
+			u64 sunder_filter_indices_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, u64* indices) \
+			{ \
+				if (buffer == nullptr || indices == nullptr || element_count == 0) { return 0; } \
+				return sunder_filter_internal<type, false>(buffer, 0, element_count, predicate, operand, sentinel, indices, nullptr); \
+			} \
+			\
+			u64 sunder_filter_values_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, type* values) \
+			{ \
+				if (buffer == nullptr || values == nullptr || element_count == 0) { return 0; } \
+				return sunder_filter_internal<type, true>(buffer, 0, element_count, predicate, operand, sentinel, nullptr, values); \
+			} \
+			\
+			u64 sunder_filter_indices_parallel_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, u64* indices, u32 thread_count) \
+			{ \
+				if (buffer == nullptr || indices == nullptr || element_count == 0) { return 0; } \
+				return sunder_filter_parallel_internal<type>(buffer, element_count, predicate, operand, sentinel, indices, nullptr, thread_count); \
+			} \
+			\
+			u64 sunder_filter_values_parallel_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, type* values, u32 thread_count) \
+			{ \
+				if (buffer == nullptr || values == nullptr || element_count == 0) { return 0; } \
+				return sunder_filter_parallel_internal<type>(buffer, element_count, predicate, operand, sentinel, nullptr, values, thread_count); \
+			}
+
+SUNDER_IMPLEMENT_FILTER_FUNCTIONS(u8, u8)
+SUNDER_IMPLEMENT_FILTER_FUNCTIONS(u16, u16)
+SUNDER_IMPLEMENT_FILTER_FUNCTIONS(u32, u32)
+SUNDER_IMPLEMENT_FILTER_FUNCTIONS(u64, u64)
+SUNDER_IMPLEMENT_FILTER_FUNCTIONS(f32, f32)
+SUNDER_IMPLEMENT_FILTER_FUNCTIONS(f64, f64)
+
+struct sunder_thread_scratch_t
 {
-	return sunder_align64(sunder_compute_array_size_in_bytes(type_size_in_bytes, element_count), alignment);
-}
+	sunder_arena_t arena;
+	u64 high_water_mark = 0;
+
+	~sunder_thread_scratch_t()
+	{
+		if (arena.buffer != nullptr) { sunder_free_arena(&arena); }
+	}
+};
 
+SUNDER_INTERNAL thread_local sunder_thread_scratch_t sunder_thread_scratch;
 
-u8 sunder_to_bit_mask8(const sunder_bit_index_buffer8_t& storage, u32 count)
+sunder_arena_t* sunder_get_thread_scratch_arena()
 {
-	u8 mask = 0;
-	u8 merged_count = 0;
-	const u16 bit_count = sizeof(u8) * 8;
+	sunder_arena_t* arena = &sunder_thread_scratch.arena;
 
-	SUNDER_TO_BIT_MASK(u8, 1, mask, storage, count, merged_count, bit_count);
-	if (mask == 0) { return UINT8_MAX; }
-	if (merged_count != count) { return UINT8_MAX; }
+	if (arena->buffer == nullptr)
+	{
+		sunder_arena_allocation_data_t allocation_data;
+		allocation_data.arena_allocation_size = SUNDER_DEFAULT_THREAD_SCRATCH_ARENA_CAPACITY;
+		allocation_data.arena_allocation_alignment = SUNDER_DEFAULT_THREAD_SCRATCH_ARENA_ALIGNMENT;
+		allocation_data.flags = SUNDER_BIT_TO_MASK(SUNDER_ARENA_BITS_ALLOW_CHAINING_BIT, 1u);
 
-	return mask;
+		if (sunder_allocate_arena(arena, &allocation_data) != SUNDER_ARENA_RESULT_SUCCESS) { return nullptr; }
+	}
+
+	return arena;
 }
 
-u16 sunder_to_bit_mask16(const sunder_bit_index_buffer16_t& storage, u32 count)
+void sunder_reset_thread_scratch_arena()
 {
-	u16 mask = 0;
-	u16 merged_count = 0;
-	const u16 bit_count = sizeof(u16) * 8;
+	sunder_arena_t* arena = &sunder_thread_scratch.arena;
+	if (arena->buffer == nullptr) { return; }
 
-	SUNDER_TO_BIT_MASK(u16, 1, mask, storage, count, merged_count, bit_count);
-	if (mask == 0) { return UINT16_MAX; }
-	if (merged_count != count) { return UINT16_MAX; }
+	const u64 used_bytes = sunder_get_arena_used_bytes_internal(arena);
+	if (used_bytes > sunder_thread_scratch.high_water_mark) { sunder_thread_scratch.high_water_mark = used_bytes; }
 
-	return mask;
+	// a job that outgrew the scratch arena gets one block big enough for the next job
+	if (arena->chain_count > 0) { sunder_converge_arena_chain(arena); }
+	else { sunder_reset_arena(arena); }
 }
 
-u32 sunder_to_bit_mask32(const sunder_bit_index_buffer32_t& storage, u32 count)
+u64 sunder_get_thread_scratch_arena_high_water_mark()
 {
-	u32 mask = 0;
-	u32 merged_count = 0;
-	const u16 bit_count = sizeof(u32) * 8;
+	const sunder_arena_t* arena = &sunder_thread_scratch.arena;
+	if (arena->buffer == nullptr) { return sunder_thread_scratch.high_water_mark; }
 
-	SUNDER_TO_BIT_MASK(u32, 1U, mask, storage, count, merged_count, bit_count);
-	if (mask == 0) { return UINT32_MAX; }
-	if (merged_count != count) { return UINT32_MAX; }
+	const u64 used_bytes = sunder_get_arena_used_bytes_internal(arena);
 
-	return mask;
+	return used_bytes > sunder_thread_scratch.high_water_mark ? used_bytes : sunder_thread_scratch.high_water_mark;
 }
 
-u64 sunder_to_bit_mask64(const sunder_bit_index_buffer64_t& storage, u32 count)
+// no converge here, the scratch arena of a launched thread is freed on exit anyway
+SUNDER_INTERNAL u64 sunder_finish_thread_scratch_job_internal()
 {
-	u64 mask = 0;
-	u64 merged_count = 0;
-	const u16 bit_count = sizeof(u64) * 8;
+	const u64 high_water_mark = sunder_get_thread_scratch_arena_high_water_mark();
+	sunder_thread_scratch.high_water_mark = high_water_mark;
 
-	SUNDER_TO_BIT_MASK(u64, 1ULL, mask, storage, count, merged_count, bit_count);
-	if (mask == 0) { return UINT64_MAX; }
-	if (merged_count != count) { return UINT64_MAX; }
+	if (sunder_thread_scratch.arena.buffer != nullptr) { sunder_reset_arena(&sunder_thread_scratch.arena); }
 
-	return mask;
+	return high_water_mark;
 }
 
-SUNDER_IMPLEMENT_EXISTS_FUNCTION(u32, sunder, u32, u32)
+SUNDER_INTERNAL void sunder_run_launched_thread_internal(sunder_thread_t* thread, sunder_thread_function_ptr function_ptr, void* args)
+{
+	function_ptr(args);
+	thread->scratch_high_water_mark = sunder_finish_thread_scratch_job_internal();
+}
 
 void sunder_invoke_function_on_thread_launch(sunder_thread_function_ptr function_ptr, void* args)
 {
 	function_ptr(args);
+	sunder_finish_thread_scratch_job_internal();
 }
 
 void sunder_launch_thread(sunder_thread_t* thread, sunder_thread_function_ptr function_ptr, void* args)
 {
-	thread->thread = std::thread(function_ptr, args);
+	thread->scratch_high_water_mark = 0;
+	thread->thread = std::thread(sunder_run_launched_thread_internal, thread, function_ptr, args);
 }
 
 void sunder_join_thread(sunder_thread_t* thread)
@@ -505,10 +4370,361 @@ bool sunder_compare_strings(cstring_literal* str1, u32 str1_size, cstring_litera
 	return true;
 }
 
-SUNDER_IMPLEMENT_QUERY_BUFFER_INDEX_FUNCTION(u32, sunder, u32, u32)
+sunder_buffer_index_query_result_u32_t sunder_query_buffer_index_u32(const u32* buffer, u32 starting_index, u32 ending_index, u32 val_at_index, bool reverse_logic)
+{
+	sunder_buffer_index_query_result_u32_t res;
+
+	const u64 index = reverse_logic ? sunder_find_first_not_u32(buffer, starting_index, ending_index, val_at_index) : sunder_find_first_u32(buffer, starting_index, ending_index, val_at_index);
+	if (index == SUNDER_SEARCH_NOT_FOUND) { return res; }
+
+	res.value_at_index = buffer[index];
+	res.return_index = (u32)index;
+
+	return res;
+}
 
 SUNDER_IMPLEMENT_QUICK_SORT_PARTITION_FUNCTION(sunder_arena_free_memory_block_t, arena_free_memory_block, sunder)
 SUNDER_IMPLEMENT_QUICK_SORT_FUNCTION(sunder_arena_free_memory_block_t, arena_free_memory_block, sunder)
+SUNDER_IMPLEMENT_QUICK_SORT_PARTITION_FUNCTION(sunder_buffer_copy_data_t, buffer_copy_data, sunder)
+SUNDER_IMPLEMENT_QUICK_SORT_FUNCTION(sunder_buffer_copy_data_t, buffer_copy_data, sunder)
+
+// keys are mapped to unsigned integers that order the same way, floats get their sign bit flipped (and every other bit too when negative)
+struct sunder_radix_sort_key_u16_t { u16 operator()(u16 key) const { return key; } };
+struct sunder_radix_sort_key_u32_t { u32 operator()(u32 key) const { return key; } };
+struct sunder_radix_sort_key_u64_t { u64 operator()(u64 key) const { return key; } };
+
+struct sunder_radix_sort_key_f32_t
+{
+	u32 operator()(f32 key) const
+	{
+		u32 bits = 0;
+		memcpy(&bits, &key, sizeof(bits));
+		return bits ^ ((u32)-(i32)(bits >> 31) | 0x80000000u);
+	}
+};
+
+struct sunder_radix_sort_key_arena_free_memory_block_t { u64 operator()(const sunder_arena_free_memory_block_t& block) const { return block.suballocation_starting_offset; } };
+
+// one read to build the histograms of every digit, then one scatter per digit ping ponging between elements and scratch,
+// digits every element shares are skipped (e.g. the upper bits of small offsets)
+template<typename element_type, typename key_function>
+SUNDER_INTERNAL sunder_arena_result sunder_radix_sort_internal(element_type* elements, u64* values, u64 element_count, sunder_radix_sort_digit_width digit_width, sunder_arena_t* scratch_arena, key_function key_of)
+{
+	typedef decltype(key_of(elements[0])) key_type;
+
+	if (digit_width != SUNDER_RADIX_SORT_DIGIT_WIDTH_8 && digit_width != SUNDER_RADIX_SORT_DIGIT_WIDTH_11) { return SUNDER_ARENA_RESULT_FAILURE; }
+	if (element_count < 2) { return SUNDER_ARENA_RESULT_SUCCESS; }
+	if (elements == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+	if (scratch_arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+
+	const u32 digit_bits = (u32)digit_width;
+	const u32 pass_count = (sizeof(key_type) * 8 + digit_bits - 1) / digit_bits;
+	const u64 bucket_count = 1ull << digit_bits;
+	const u64 digit_mask = bucket_count - 1;
+
+	const sunder_arena_marker_t marker = sunder_get_arena_marker(scratch_arena);
+
+	const sunder_arena_suballocation_result_t histogram_allocation = sunder_suballocate_from_arena(scratch_arena, sizeof(u64) * bucket_count * pass_count, alignof(u64));
+	const sunder_arena_suballocation_result_t element_allocation = histogram_allocation.result == SUNDER_ARENA_RESULT_SUCCESS ? sunder_suballocate_from_arena(scratch_arena, sizeof(element_type) * element_count, alignof(element_type)) : histogram_allocation;
+	const sunder_arena_suballocation_result_t value_allocation = values != nullptr && element_allocation.result == SUNDER_ARENA_RESULT_SUCCESS ? sunder_suballocate_from_arena(scratch_arena, sizeof(u64) * element_count, alignof(u64)) : element_allocation;
+
+	if (value_allocation.result != SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		sunder_rollback_arena_to_marker(scratch_arena, &marker);
+		return value_allocation.result;
+	}
+
+	u64* histograms = (u64*)histogram_allocation.data;
+
+	for (u64 i = 0; i < bucket_count * pass_count; i++)
+	{
+		histograms[i] = 0;
+	}
+
+	for (u64 i = 0; i < element_count; i++)
+	{
+		const key_type key = key_of(elements[i]);
+
+		for (u32 pass = 0; pass < pass_count; pass++)
+		{
+			histograms[pass * bucket_count + (((u64)key >> (pass * digit_bits)) & digit_mask)]++;
+		}
+	}
+
+	element_type* src = elements;
+	element_type* dst = (element_type*)element_allocation.data;
+	u64* src_values = values;
+	u64* dst_values = values != nullptr ? (u64*)value_allocation.data : nullptr;
+
+	for (u32 pass = 0; pass < pass_count; pass++)
+	{
+		u64* offsets = histograms + pass * bucket_count;
+		const u32 shift = pass * digit_bits;
+
+		if (offsets[((u64)key_of(src[0]) >> shift) & digit_mask] == element_count) { continue; }
+
+		u64 running_offset = 0;
+
+		for (u64 bucket = 0; bucket < bucket_count; bucket++)
+		{
+			const u64 count = offsets[bucket];
+			offsets[bucket] = running_offset;
+			running_offset += count;
+		}
+
+		for (u64 i = 0; i < element_count; i++)
+		{
+			const u64 destination = offsets[((u64)key_of(src[i]) >> shift) & digit_mask]++;
+			dst[destination] = src[i];
+
+			if (values != nullptr) { dst_values[destination] = src_values[i]; }
+		}
+
+		element_type* const swapped_elements = src;
+		src = dst;
+		dst = swapped_elements;
+
+		u64* const swapped_values = src_values;
+		src_values = dst_values;
+		dst_values = swapped_values;
+	}
+
+	if (src != elements)
+	{
+		sunder_copy_bytes_internal((u8*)elements, (const u8*)src, sizeof(element_type) * element_count);
+		if (values != nullptr) { sunder_copy_bytes_internal((u8*)values, (const u8*)src_values, sizeof(u64) * element_count); }
+	}
+
+	sunder_rollback_arena_to_marker(scratch_arena, &marker);
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+#define SUNDER_IMPLEMENT_RADIX_SORT_FUNCTIONS(type, type_name) \
+			sunder_arena_result sunder_radix_sort_##type_name(type* keys, u64 element_count, sunder_radix_sort_digit_width digit_width, sunder_arena_t* scratch_arena) \
+			{ \
+				return sunder_radix_sort_internal(keys, nullptr, element_count, digit_width, scratch_arena, sunder_radix_sort_key_##type_name##_t{}); \
+			} \
+			\
+			sunder_arena_result sunder_radix_sort_pairs_##type_name(type* keys, u64* values, u64 element_count, sunder_radix_sort_digit_width digit_width, sunder_arena_t* scratch_arena) \
+			{ \
+				if (values == nullptr && element_count > 1) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; } \
+				return sunder_radix_sort_internal(keys, values, element_count, digit_width, scratch_arena, sunder_radix_sort_key_##type_name##_t{}); \
+			}
+
+SUNDER_IMPLEMENT_RADIX_SORT_FUNCTIONS(u16, u16)
+SUNDER_IMPLEMENT_RADIX_SORT_FUNCTIONS(u32, u32)
+SUNDER_IMPLEMENT_RADIX_SORT_FUNCTIONS(u64, u64)
+SUNDER_IMPLEMENT_RADIX_SORT_FUNCTIONS(f32, f32)
+SUNDER_IMPLEMENT_RADIX_SORT_FUNCTIONS(sunder_arena_free_memory_block_t, arena_free_memory_block)
+
+template<typename type>
+struct sunder_sort_less_t
+{
+	bool operator()(const type* a, const type* b) const { return *a < *b; }
+};
+
+template<>
+struct sunder_sort_less_t<sunder_arena_free_memory_block_t>
+{
+	bool operator()(const sunder_arena_free_memory_block_t* a, const sunder_arena_free_memory_block_t* b) const { return a->suballocation_starting_offset < b->suballocation_starting_offset; }
+};
+
+enum sunder_parallel_sort_job_kind : u32
+{
+	SUNDER_PARALLEL_SORT_JOB_KIND_SORT = 0u,
+	SUNDER_PARALLEL_SORT_JOB_KIND_MERGE = 1u
+};
+
+// sort jobs introsort [output_begin, output_end) of left in place,
+// merge jobs write outputs [output_begin, output_end) of the stable merge of left and right (right may be empty to copy a lone run over)
+template<typename type, typename comparison_type>
+struct sunder_parallel_sort_job_t
+{
+	u32 kind = SUNDER_PARALLEL_SORT_JOB_KIND_SORT;
+	type* left = nullptr;
+	u64 left_count = 0;
+	const type* right = nullptr;
+	u64 right_count = 0;
+	type* output = nullptr;
+	u64 output_begin = 0;
+	u64 output_end = 0;
+	comparison_type comparison_function;
+};
+
+// amount of elements of left among the first output_index outputs of the stable merge (merge path co-rank)
+template<typename type, typename comparison_type>
+SUNDER_INTERNAL u64 sunder_merge_co_rank_internal(u64 output_index, const type* left, u64 left_count, const type* right, u64 right_count, comparison_type comparison_function)
+{
+	u64 low = output_index > right_count ? output_index - right_count : 0;
+	u64 high = output_index < left_count ? output_index : left_count;
+
+	while (low < high)
+	{
+		const u64 i = low + (high - low) / 2;
+		const u64 j = output_index - i;
+
+		if (j == 0 || i == left_count || comparison_function(&right[j - 1], &left[i])) { high = i; }
+		else { low = i + 1; }
+	}
+
+	return low;
+}
+
+template<typename type, typename comparison_type>
+SUNDER_INTERNAL void sunder_run_parallel_sort_job_internal(void* args)
+{
+	sunder_parallel_sort_job_t<type, comparison_type>* job = (sunder_parallel_sort_job_t<type, comparison_type>*)args;
+
+	if (job->kind == SUNDER_PARALLEL_SORT_JOB_KIND_SORT)
+	{
+		sunder_introsort(job->left, (i64)job->output_begin, (i64)job->output_end - 1, job->comparison_function);
+		return;
+	}
+
+	u64 i = sunder_merge_co_rank_internal(job->output_begin, job->left, job->left_count, job->right, job->right_count, job->comparison_function);
+	u64 j = job->output_begin - i;
+
+	for (u64 k = job->output_begin; k < job->output_end; k++)
+	{
+		const bool take_right = j < job->right_count && (i == job->left_count || job->comparison_function(&job->right[j], &job->left[i]));
+		job->output[k] = take_right ? job->right[j++] : job->left[i++];
+	}
+}
+
+template<typename type, typename comparison_type>
+SUNDER_INTERNAL void sunder_run_parallel_sort_jobs_internal(sunder_parallel_sort_job_t<type, comparison_type>* jobs, u32 job_count)
+{
+	sunder_thread_t workers[SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT];
+
+	for (u32 i = 1; i < job_count; i++)
+	{
+		sunder_launch_thread(&workers[i], sunder_run_parallel_sort_job_internal<type, comparison_type>, &jobs[i]);
+	}
+
+	sunder_run_parallel_sort_job_internal<type, comparison_type>(&jobs[0]);
+
+	for (u32 i = 1; i < job_count; i++)
+	{
+		sunder_join_thread(&workers[i]);
+	}
+}
+
+// every worker introsorts one run, then neighbouring runs are merged pairwise into the scratch buffer and back,
+// each merge is split at co-ranked output positions so all workers stay busy even in the last round
+template<typename type, typename comparison_type>
+SUNDER_INTERNAL sunder_arena_result sunder_parallel_sort_internal(type* buffer, u64 element_count, u32 thread_count, sunder_arena_t* scratch_arena, comparison_type comparison_function)
+{
+	if (element_count < 2) { return SUNDER_ARENA_RESULT_SUCCESS; }
+	if (buffer == nullptr) { return SUNDER_ARENA_RESULT_BUFFER_UNINITIALIZED; }
+
+	u32 worker_count = thread_count < SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT ? thread_count : SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT;
+	if (worker_count > element_count / SUNDER_PARALLEL_SORT_MIN_ELEMENTS_PER_THREAD) { worker_count = (u32)(element_count / SUNDER_PARALLEL_SORT_MIN_ELEMENTS_PER_THREAD); }
+
+	if (worker_count <= 1)
+	{
+		sunder_introsort(buffer, 0, (i64)element_count - 1, comparison_function);
+		return SUNDER_ARENA_RESULT_SUCCESS;
+	}
+
+	if (scratch_arena == nullptr) { return SUNDER_ARENA_RESULT_ARENA_UNINITIALIZED; }
+
+	const sunder_arena_marker_t marker = sunder_get_arena_marker(scratch_arena);
+	const sunder_arena_suballocation_result_t scratch = sunder_suballocate_from_arena(scratch_arena, sizeof(type) * element_count, alignof(type));
+
+	if (scratch.result != SUNDER_ARENA_RESULT_SUCCESS)
+	{
+		sunder_rollback_arena_to_marker(scratch_arena, &marker);
+		return scratch.result;
+	}
+
+	sunder_parallel_sort_job_t<type, comparison_type> jobs[SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT];
+	u64 run_bounds[SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT + 1];
+	u32 run_count = worker_count;
+
+	for (u32 i = 0; i <= run_count; i++)
+	{
+		run_bounds[i] = element_count * i / run_count;
+	}
+
+	for (u32 i = 0; i < run_count; i++)
+	{
+		jobs[i].kind = SUNDER_PARALLEL_SORT_JOB_KIND_SORT;
+		jobs[i].left = buffer;
+		jobs[i].output_begin = run_bounds[i];
+		jobs[i].output_end = run_bounds[i + 1];
+		jobs[i].comparison_function = comparison_function;
+	}
+
+	sunder_run_parallel_sort_jobs_internal(jobs, run_count);
+
+	type* src = buffer;
+	type* dst = (type*)scratch.data;
+
+	while (run_count > 1)
+	{
+		const u32 merged_run_count = (run_count + 1) / 2;
+		const u32 parts_per_run = worker_count / merged_run_count > 0 ? worker_count / merged_run_count : 1;
+		u32 job_count = 0;
+
+		for (u32 run = 0; run < merged_run_count; run++)
+		{
+			const u64 left_begin = run_bounds[run * 2];
+			const u64 right_begin = run_bounds[run * 2 + 1];
+			const u64 right_end = run * 2 + 2 <= run_count ? run_bounds[run * 2 + 2] : right_begin;
+			const u64 merged_count = right_end - left_begin;
+
+			// a lone last run is copied over by a single job
+			const u32 parts = right_end == right_begin ? 1 : parts_per_run;
+
+			for (u32 part = 0; part < parts; part++)
+			{
+				sunder_parallel_sort_job_t<type, comparison_type>* job = &jobs[job_count++];
+				job->kind = SUNDER_PARALLEL_SORT_JOB_KIND_MERGE;
+				job->left = src + left_begin;
+				job->left_count = right_begin - left_begin;
+				job->right = src + right_begin;
+				job->right_count = right_end - right_begin;
+				job->output = dst + left_begin;
+				job->output_begin = merged_count * part / parts;
+				job->output_end = merged_count * (part + 1) / parts;
+				job->comparison_function = comparison_function;
+			}
+		}
+
+		sunder_run_parallel_sort_jobs_internal(jobs, job_count);
+
+		for (u32 run = 0; run < merged_run_count; run++)
+		{
+			run_bounds[run] = run_bounds[run * 2];
+		}
+
+		run_bounds[merged_run_count] = element_count;
+		run_count = merged_run_count;
+
+		type* const swapped = src;
+		src = dst;
+		dst = swapped;
+	}
+
+	if (src != buffer) { sunder_copy_bytes_internal((u8*)buffer, (const u8*)src, sizeof(type) * element_count); }
+
+	sunder_rollback_arena_to_marker(scratch_arena, &marker);
+
+	return SUNDER_ARENA_RESULT_SUCCESS;
+}
+
+#define SUNDER_IMPLEMENT_PARALLEL_SORT_FUNCTION(type, type_name) \
+			sunder_arena_result sunder_parallel_sort_##type_name(type* buffer, u64 element_count, u32 thread_count, sunder_arena_t* scratch_arena) \
+			{ \
+				return sunder_parallel_sort_internal(buffer, element_count, thread_count, scratch_arena, sunder_sort_less_t<type>{}); \
+			}
+
+SUNDER_IMPLEMENT_PARALLEL_SORT_FUNCTION(u32, u32)
+SUNDER_IMPLEMENT_PARALLEL_SORT_FUNCTION(u64, u64)
+SUNDER_IMPLEMENT_PARALLEL_SORT_FUNCTION(f32, f32)
+SUNDER_IMPLEMENT_PARALLEL_SORT_FUNCTION(f64, f64)
+SUNDER_IMPLEMENT_PARALLEL_SORT_FUNCTION(sunder_arena_free_memory_block_t, arena_free_memory_block)
 
 void sunder_log_string(const sunder_string_t* string)
 {
@@ -560,15 +4776,8 @@ bool sunder_valid_offset(u64 offset, u64 capacity)
 
 u64 sunder_compute_aligned_array_allocation_size(u64 type_size_in_bytes, u64 element_count, u32 alignment)
 {
-	u64 aligned_allocation_size = 0;
-
-	for (u64 i = 0; i < element_count; i++)
-	{
-		aligned_allocation_size += sunder_align64(type_size_in_bytes, alignment);
-		aligned_allocation_size = sunder_align64(aligned_allocation_size, alignment); // probably obsolete
-	}
-
-	return aligned_allocation_size;
+	// every element is padded to a multiple of alignment so the running total never needs realigning
+	return sunder_align64(type_size_in_bytes, alignment) * element_count;
 }
 
 u64 sunder_accumulate_aligned_allocation_size(const u64* aligned_allocation_size_buffer, u64 element_count, u32 alignment)
@@ -122,6 +122,10 @@
 				return val; \
 			}
 
+#define SUNDER_SORT_INSERTION_SORT_THRESHOLD 24
+#define SUNDER_SORT_NINTHER_THRESHOLD 128
+#define SUNDER_SORT_PARTIAL_INSERTION_SORT_MAX_MOVES 8u
+
 #define SUNDER_DEFINE_QUICK_SORT_COMPARE_FUNCTION(type) bool (*comparison_function)(const type*, const type*)
 
 #define SUNDER_DEFINE_QUICK_SORT_PARTITION_FUNCTION(type, type_name, prefix) \
@@ -158,15 +162,7 @@
 #define SUNDER_IMPLEMENT_QUICK_SORT_FUNCTION(type, type_name,  prefix) \
 			 void prefix##_quick_sort_##type_name(type* buffer, i64 starting_index, i64 ending_index, SUNDER_DEFINE_QUICK_SORT_COMPARE_FUNCTION(type)) \
 			{ \
-				if(ending_index <= starting_index)\
-				{\
-					return;\
-				}\
-				\
-				const i64 pivot = prefix##_quick_sort_partition_##type_name(buffer, starting_index, ending_index, comparison_function);\
-				\
-				prefix##_quick_sort_##type_name(buffer, starting_index, pivot - 1, comparison_function);\
-				prefix##_quick_sort_##type_name(buffer, pivot + 1, ending_index, comparison_function);\
+				sunder_introsort(buffer, starting_index, ending_index, comparison_function);\
 			}
 
 #define SUNDER_DEFINE_EXISTS_FUNCTION(type, prefix, type_name, index_type) \
@@ -206,7 +202,7 @@
 				\
 				if (reverse_logic)\
 				{\
-					for (u32 i = starting_index; i < ending_index; i++)\
+					for (index_type i = starting_index; i < ending_index; i++)\
 					{\
 						if (buffer[i] != val_at_index)\
 						{\
@@ -222,7 +218,7 @@
 				\
 				else\
 				{\
-					for (u32 i = starting_index; i < ending_index; i++)\
+					for (index_type i = starting_index; i < ending_index; i++)\
 					{\
 						if (buffer[i] == val_at_index)\
 						{\
@@ -240,13 +236,61 @@
 			\
 		}
 
+#define SUNDER_SEARCH_NOT_FOUND UINT64_MAX
+
+// find_first / find_first_not return SUNDER_SEARCH_NOT_FOUND when nothing in [starting_index, ending_index) qualifies, find_all returns the amount of matches but only writes the first index_capacity indices
+#define SUNDER_DEFINE_SEARCH_FUNCTIONS(type, type_name) \
+			u64 sunder_find_first_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val); \
+			u64 sunder_find_first_not_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val); \
+			u64 sunder_count_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val); \
+			u64 sunder_find_all_##type_name(const type* buffer, u64 starting_index, u64 ending_index, type val, u64* indices, u64 index_capacity);
+
+// dense counterpart of SUNDER_CONDITIONAL_EXECUTION, output has to hold element_count entries, returns amount of entries written (in buffer order)
+#define SUNDER_DEFINE_FILTER_FUNCTIONS(type, type_name) \
+			u64 sunder_filter_indices_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, u64* indices); \
+			u64 sunder_filter_values_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, type* values); \
+			u64 sunder_filter_indices_parallel_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, u64* indices, u32 thread_count); \
+			u64 sunder_filter_values_parallel_##type_name(const type* buffer, u64 element_count, sunder_filter_predicate predicate, type operand, type sentinel, type* values, u32 thread_count);
+
+// stable lsd radix sort, scratch (element_count keys / values + the digit histograms) comes from scratch_arena and is rolled back before returning
+#define SUNDER_DEFINE_RADIX_SORT_FUNCTIONS(type, type_name) \
+			sunder_arena_result sunder_radix_sort_##type_name(type* keys, u64 element_count, sunder_radix_sort_digit_width digit_width, sunder_arena_t* scratch_arena); \
+			sunder_arena_result sunder_radix_sort_pairs_##type_name(type* keys, u64* values, u64 element_count, sunder_radix_sort_digit_width digit_width, sunder_arena_t* scratch_arena);
+
+// ascending, not stable, scratch (element_count elements) comes from scratch_arena and is rolled back before returning
+#define SUNDER_DEFINE_PARALLEL_SORT_FUNCTION(type, type_name) \
+			sunder_arena_result sunder_parallel_sort_##type_name(type* buffer, u64 element_count, u32 thread_count, sunder_arena_t* scratch_arena);
+
 #define SUNDER_BIT_TO_MASK(bit, shift) (shift << (bit))
 
 #define SUNDER_DEFAULT_ARENA_FREE_BUFFER_ELEMENT_COUNT 32u
+#define SUNDER_ARENA_FREE_BLOCK_NONE UINT32_MAX
 #define SUNDER_DEFAULT_ARENA_FREE_CHUNK_BUFFER_ELEMENT_COUNT 32u
 #define SUNDER_DEFAULT_ARENA_ELEMENT_COUNT_PER_FREE_CHUNK 4u
 #define SUNDER_ARENA_SUBALLOCATION_MIN_ALIGNMENT 2u
 #define SUNDER_ARENA_SUBALLOCATION_MAX_ALIGNMENT 4096u
+#define SUNDER_ARENA_VIRTUAL_MEMORY_COMMIT_GRANULARITY 65536u
+#define SUNDER_ARENA_HUGE_PAGE_SIZE 2097152u
+#define SUNDER_DEFAULT_THREAD_SCRATCH_ARENA_CAPACITY 1048576u
+#define SUNDER_DEFAULT_THREAD_SCRATCH_ARENA_ALIGNMENT 64u
+#define SUNDER_POOL_THREAD_CACHE_CAPACITY 64u
+#define SUNDER_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT 8u
+#define SUNDER_UNIFORM_RING_MAX_SEGMENTS 8u
+#define SUNDER_ARENA_SNAPSHOT_MAGIC 0x50414e5352444e53ull
+#define SUNDER_ARENA_SNAPSHOT_VERSION 1u
+#define SUNDER_ARENA_SNAPSHOT_DATA_OFFSET 65536u
+#define SUNDER_ALIGNED_HALLOC_MIN_SIZE_CLASS_SHIFT 6u
+#define SUNDER_ALIGNED_HALLOC_SIZE_CLASS_COUNT 15u
+#define SUNDER_ALIGNED_HALLOC_THREAD_CACHE_CAPACITY 8u
+#define SUNDER_ALLOCATION_TAG_COUNT 64u
+#define SUNDER_DEFAULT_LAST_LEVEL_CACHE_SIZE 8388608u
+#define SUNDER_COPY_BUFFER_BATCH_MAX_THREAD_COUNT 16u
+#define SUNDER_COPY_BUFFER_BATCH_MIN_BYTES_PER_THREAD 1048576u
+#define SUNDER_FILTER_MAX_THREAD_COUNT 16u
+#define SUNDER_FILTER_MIN_ELEMENTS_PER_THREAD 65536u
+#define SUNDER_PARALLEL_SORT_MAX_THREAD_COUNT 16u
+#define SUNDER_PARALLEL_SORT_MIN_ELEMENTS_PER_THREAD 65536u
+#define SUNDER_ALLOCATION_TAG_HISTOGRAM_BUCKET_COUNT 48u
 #define SUNDER_PRE_FREE_CAST(ptr) (void**)&(ptr)
 
 typedef char i8;
@@ -293,13 +337,56 @@ enum sunder_arena_result : u32
 	SUNDER_ARENA_RESULT_OUT_OF_ARENA_MEMORY = 4u,
 	SUNDER_ARENA_RESULT_INVALID_REQUESTED_ALIGNMENT = 5u,
 	SUNDER_ARENA_RESULT_OS_MEMORY_ALLOCATION_FAILURE =  6u,
-	SUNDER_ARENA_RESULT_SUCCESS_REQUESTED_ALIGNMENT_HAS_BEEN_CLAMPED_TO_2 = 7u
+	SUNDER_ARENA_RESULT_SUCCESS_REQUESTED_ALIGNMENT_HAS_BEEN_CLAMPED_TO_2 = 7u,
+	SUNDER_ARENA_RESULT_SUCCESS_HUGE_PAGES_ARE_TRANSPARENT = 8u,
+	SUNDER_ARENA_RESULT_SUCCESS_HUGE_PAGES_UNAVAILABLE = 9u,
+	SUNDER_ARENA_RESULT_OUT_OF_ORDER_ROLLBACK = 10u,
+	SUNDER_ARENA_RESULT_STALE_HANDLE = 11u,
+	SUNDER_ARENA_RESULT_COMPACTION_IN_PROGRESS = 12u,
+	SUNDER_ARENA_RESULT_SNAPSHOT_IO_FAILURE = 13u,
+	SUNDER_ARENA_RESULT_SNAPSHOT_CORRUPTED = 14u
 };
 
 enum sunder_arena_bits : u8
 {
 	SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT = 0,
-	SUNDER_ARENA_BITS_SUBALLOCATION_ALGORITHM_FIRST_SUITABLE_BIT = 1
+	SUNDER_ARENA_BITS_SUBALLOCATION_ALGORITHM_FIRST_SUITABLE_BIT = 1,
+	SUNDER_ARENA_BITS_ALLOW_CHAINING_BIT = 2,
+	SUNDER_ARENA_BITS_VIRTUAL_MEMORY_BACKEND_BIT = 3,
+	SUNDER_ARENA_BITS_HUGE_PAGES_BIT = 4,
+	SUNDER_ARENA_BITS_REGISTER_STATISTICS_BIT = 5,
+	SUNDER_ARENA_BITS_SNAPSHOT_FILE_MAPPING_BIT = 6			// set by sunder_load_arena_snapshot when the data is mapped from the file, not meant to be passed in
+};
+
+// element passes when (element predicate operand) holds and element != sentinel
+enum sunder_filter_predicate : u32
+{
+	SUNDER_FILTER_PREDICATE_LESS = 0u,
+	SUNDER_FILTER_PREDICATE_LESS_EQUAL = 1u,
+	SUNDER_FILTER_PREDICATE_EQUAL = 2u,
+	SUNDER_FILTER_PREDICATE_NOT_EQUAL = 3u,
+	SUNDER_FILTER_PREDICATE_GREATER = 4u,
+	SUNDER_FILTER_PREDICATE_GREATER_EQUAL = 5u
+};
+
+enum sunder_radix_sort_digit_width : u32
+{
+	SUNDER_RADIX_SORT_DIGIT_WIDTH_8 = 8u,
+	SUNDER_RADIX_SORT_DIGIT_WIDTH_11 = 11u
+};
+
+enum sunder_arena_snapshot_bits : u8
+{
+	SUNDER_ARENA_SNAPSHOT_BITS_READ_ONLY_BIT = 0,
+	SUNDER_ARENA_SNAPSHOT_BITS_VERIFY_CHECKSUM_BIT = 1
+};
+
+enum sunder_arena_resize_path : u32
+{
+	SUNDER_ARENA_RESIZE_PATH_NONE = 0u,
+	SUNDER_ARENA_RESIZE_PATH_IN_PLACE_GROW = 1u,
+	SUNDER_ARENA_RESIZE_PATH_IN_PLACE_SHRINK = 2u,
+	SUNDER_ARENA_RESIZE_PATH_RELOCATED = 3u
 };
 
 struct sunder_arena_free_memory_block_t
@@ -308,6 +395,18 @@ struct sunder_arena_free_memory_block_t
 	u64 suballocation_size = 0;
 };
 
+// data starts at data_offset in the file (a multiple of every page size we map with) so it can be mapped straight in
+struct sunder_arena_snapshot_header_t
+{
+	u64 magic = SUNDER_ARENA_SNAPSHOT_MAGIC;
+	u32 version = SUNDER_ARENA_SNAPSHOT_VERSION;
+	u32 alignment = 0;
+	u64 capacity = 0;
+	u64 offset = 0;
+	u64 checksum = 0;
+	u64 data_offset = SUNDER_ARENA_SNAPSHOT_DATA_OFFSET;
+};
+
 struct sunder_arena_allocation_data_t
 {
 	u64 arena_allocation_size = 0;
@@ -322,15 +421,89 @@ struct sunder_arena_suballocation_result_t
 	sunder_arena_result result = SUNDER_ARENA_RESULT_SUCCESS;
 };
 
+struct sunder_arena_resize_result_t
+{
+	void* data = nullptr;
+	sunder_arena_result result = SUNDER_ARENA_RESULT_SUCCESS;
+	sunder_arena_resize_path path = SUNDER_ARENA_RESIZE_PATH_NONE;
+};
+
+struct sunder_arena_statistics_t
+{
+	u64 allocation_count = 0;
+	u64 bytes_requested = 0;
+	u64 padding_bytes = 0;
+	u64 high_water_mark = 0;				// most bytes in use at once, chained blocks included
+	u64 out_of_memory_count = 0;
+};
+
+// size_histogram bucket i counts the tagged calls of [2^i, 2^(i + 1)) bytes, the last bucket takes everything above
+struct sunder_allocation_tag_statistics_t
+{
+	u64 live_bytes = 0;
+	u64 peak_bytes = 0;
+	u64 allocation_count = 0;
+	u64 free_count = 0;
+	u64 size_histogram[SUNDER_ALLOCATION_TAG_HISTOGRAM_BUCKET_COUNT]{};
+};
+
+// free blocks are kept in two treaps sharing their nodes: one ordered by offset (augmented with the largest block of every subtree for first fit),
+// one ordered by size, then offset (best fit), children are node indices or SUNDER_ARENA_FREE_BLOCK_NONE
+struct sunder_arena_free_block_node_t
+{
+	sunder_arena_free_memory_block_t block;
+	u64 largest_size = 0;
+	u64 priority = 0;
+	u32 offset_children[2] = { SUNDER_ARENA_FREE_BLOCK_NONE, SUNDER_ARENA_FREE_BLOCK_NONE };
+	u32 size_children[2] = { SUNDER_ARENA_FREE_BLOCK_NONE, SUNDER_ARENA_FREE_BLOCK_NONE };
+};
+
 struct sunder_arena_t
 {
 	u8* buffer = nullptr;
 	u64 capacity = 0;
 	u64 offset = 0;
-	//sunder_arena_t* chain;
-	//u32 chain_count;
-	//u32 allocation_alignment;
-	//u32 flags;
+	u64 committed = 0;					// bytes of the active block backed by memory, equals capacity unless the virtual memory backend is used
+	u64 page_size = 0;					// page size backing the active block
+	sunder_arena_t* chain = nullptr;	// previously filled blocks, most recent first (buffer / capacity / offset always describe the active block)
+	u32 chain_count = 0;
+	u32 allocation_alignment = 0;
+	u32 flags = 0;
+	sunder_arena_free_block_node_t* free_block_nodes = nullptr;		// free_block_capacity nodes, unused ones are linked through offset_children[0]
+	u32 free_block_offset_root = SUNDER_ARENA_FREE_BLOCK_NONE;
+	u32 free_block_size_root = SUNDER_ARENA_FREE_BLOCK_NONE;
+	u32 free_block_unused_node = SUNDER_ARENA_FREE_BLOCK_NONE;
+	u32 free_block_count = 0;
+	u32 free_block_capacity = 0;
+	u32 marker_depth = 0;
+	u64 retired_bytes = 0;				// sum of the offsets of every chained block
+	sunder_arena_statistics_t statistics;
+	sunder_arena_t* next_registered = nullptr;
+	sunder_arena_t* previous_registered = nullptr;
+#if defined(SUNDER_ALLOCATION_TRACKING)
+	u32 allocation_tag = UINT32_MAX;		// set by sunder_allocate_arena_tagged, every block of the arena (chained and converged ones too) is accounted to it until the arena is freed
+	u64 allocation_tag_bytes = 0;			// capacity of every block currently charged to allocation_tag
+#endif
+};
+
+struct sunder_arena_marker_t
+{
+	u64 offset = 0;
+	u32 chain_count = 0;
+	u32 depth = 0;
+};
+
+// rolls the arena back to where it was on construction
+struct sunder_arena_scope_t
+{
+	sunder_arena_t* arena = nullptr;
+	sunder_arena_marker_t marker;
+
+	explicit sunder_arena_scope_t(sunder_arena_t* scoped_arena);
+	~sunder_arena_scope_t();
+
+	sunder_arena_scope_t(const sunder_arena_scope_t&) = delete;
+	sunder_arena_scope_t& operator=(const sunder_arena_scope_t&) = delete;
 };
 
 struct sunder_timer_t
@@ -363,9 +536,127 @@ struct sunder_bit_index_buffer8_t   { u8 index_buffer[8];   };
 typedef void (*sunder_thread_function_ptr)(void*);
 typedef std::thread::id sunder_thread_id;
 
-struct sunder_thread_t { std::thread thread; };
+struct sunder_thread_t
+{
+	std::thread thread;
+	u64 scratch_high_water_mark = 0;		// the thread's scratch arena high water mark, written when the function returns, read it after sunder_join_thread
+};
+// replaces the allocator underneath sunder_aligned_halloc / sunder_aligned_free, allocate has to honor alignment (always a power of 2 and at least 16)
+struct sunder_aligned_allocation_backend_t
+{
+	void* (*allocate)(u64 bytes, u64 alignment, void* user_data) = nullptr;
+	void (*free)(void* memblock, void* user_data) = nullptr;
+	void* user_data = nullptr;
+};
+
 struct sunder_mutex_t { std::mutex mutex; };
 
+// fixed size slots carved out of arena blocks, free slots form an intrusive list through their first bytes
+struct sunder_pool_t
+{
+	sunder_arena_t* arena = nullptr;
+	void* free_list = nullptr;
+	u8* block_cursor = nullptr;
+	u8* block_end = nullptr;
+	u64 slot_size = 0;
+	u32 slot_alignment = 0;
+	u32 slots_per_block = 0;
+	sunder_mutex_t mutex;				// only taken by thread cache refills / flushes
+};
+
+// ring of transient memory, a frame's region is only recycled once that frame has been completed (etc. its gpu fence signaled)
+struct sunder_frame_arena_t
+{
+	u8* buffer = nullptr;
+	u64 capacity = 0;
+	u64 head = 0;						// head / tail / lap_start are virtual offsets that only ever grow, the physical offset is head - lap_start
+	u64 tail = 0;
+	u64 lap_start = 0;
+	u64 frame_ends[SUNDER_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT]{};
+	bool frame_completed[SUNDER_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT]{};
+	u64 next_frame = 0;
+	u64 oldest_frame = 0;
+	u32 frames_in_flight = 0;
+	bool recording = false;
+};
+
+// linear per frame segments of host memory for dynamic uniform offsets, every offset is a multiple of min_offset_alignment
+struct sunder_uniform_ring_t
+{
+	u8* buffer = nullptr;
+	u64 capacity = 0;
+	u64 segment_size = 0;
+	u64 min_offset_alignment = 0;
+	u64 cursor = 0;					// relative to the active segment, advanced with a compare exchange loop
+	u32 segment_count = 0;
+	u32 segment_index = 0;
+};
+
+struct sunder_uniform_ring_suballocation_t
+{
+	void* data = nullptr;
+	u64 offset = 0;					// relative to the start of the whole ring buffer
+	sunder_arena_result result = SUNDER_ARENA_RESULT_SUCCESS;
+};
+
+// power of 2 blocks from min_block_size up to capacity, tree holds (largest free order + 1) per node, 0 meaning nothing is free below it
+struct sunder_buddy_allocator_t
+{
+	u8* buffer = nullptr;
+	u8* tree = nullptr;
+	u64 capacity = 0;
+	u64 min_block_size = 0;
+	u64 free_bytes = 0;
+	u32 min_block_shift = 0;
+	u32 max_order = 0;
+};
+
+// generation 0 is never handed out, a zero initialized handle is always stale
+struct sunder_arena_handle_t
+{
+	u32 index = 0;
+	u32 generation = 0;
+};
+
+struct sunder_arena_handle_suballocation_result_t
+{
+	sunder_arena_handle_t handle;
+	sunder_arena_result result = SUNDER_ARENA_RESULT_SUCCESS;
+};
+
+struct sunder_arena_handle_entry_t
+{
+	u64 offset = 0;
+	u64 size = 0;
+	u64 padding = 0;					// alignment gap behind the suballocation, compaction hands it over so no free block is left between two live ones
+	u32 alignment = 0;
+	u32 generation = 0;
+	u32 next_free_entry = 0;
+	bool live = false;
+};
+
+// relocatable suballocations from a free buffer arena, data is only reachable through handles so compaction may move it
+struct sunder_handle_arena_t
+{
+	sunder_arena_t arena;
+	sunder_arena_handle_entry_t* entries = nullptr;
+	u32* live_entries = nullptr;		// entry indices sorted by offset, compaction walks this instead of sorting
+	u32 entry_capacity = 0;
+	u32 entry_count = 0;
+	u32 live_count = 0;
+	u32 free_entry_head = UINT32_MAX;
+	u32 compaction_index = 0;			// position in live_entries the next compaction step resumes from
+	bool compacting = false;
+};
+
+// owned by a single thread, trades slots with the pool in batches of SUNDER_POOL_THREAD_CACHE_CAPACITY / 2
+struct sunder_pool_thread_cache_t
+{
+	sunder_pool_t* pool = nullptr;
+	void* slots[SUNDER_POOL_THREAD_CACHE_CAPACITY];
+	u32 slot_count = 0;
+};
+
 static std::chrono::steady_clock::time_point sunder_initial_time;
 
 typedef bool (*sunder_quick_sort_comparison_function_ptr)(const void*, const void*);
@@ -376,6 +667,12 @@ void*													sunder_aligned_halloc(u64 type_size_in_bytes, u64 element_coun
 void*													sunder_aligned_halloc(u64 bytes, u64 alignment);
 void														sunder_free(void** memblock);
 void														sunder_aligned_free(void** memblock);
+
+															// call before the first aligned allocation, blocks still alive when the backend is swapped would be handed to the wrong free, nullptr restores the default (posix_memalign / _aligned_malloc)
+void														sunder_set_aligned_allocation_backend(const sunder_aligned_allocation_backend_t* backend);
+
+															// hands every block cached by the calling thread back to the backend, happens automatically on thread exit
+void														sunder_flush_aligned_halloc_thread_cache();
 bool														sunder_is_valid(const void* memblock);
 void														sunder_rand_seed();
 i16														sunder_rand_i16(i16 start, i16 end);
@@ -386,29 +683,165 @@ u32														sunder_rand_u32(u32 start, u32 end);
 u64														sunder_rand_u64(u64 start, u64 end);
 
 															// returns amount of bytes written
+															// overlapping ranges are copied as if through a temporary buffer, copies larger than the last level cache bypass it with non temporal stores
 u64														sunder_copy_buffer(void* dst, const void* src, const sunder_buffer_copy_data_t* copying_data);
+
+															// every descriptor is validated up front (nothing is copied if one fails, 0 is returned), descriptors are sorted by dst_offset and touching ranges merged using the thread scratch arena
+															// destination ranges must not overlap each other nor any source range, thread_count > 1 splits batches of at least SUNDER_COPY_BUFFER_BATCH_MIN_BYTES_PER_THREAD bytes per thread across worker threads
+u64														sunder_copy_buffer_batch(void* dst, const void* src, const sunder_buffer_copy_data_t* copying_data, u64 copy_count, u32 thread_count);
 bool														sunder_is_divisible_by(u64 val, u64 div);
 bool														sunder_is_even(u64 val);
 bool														sunder_is_power_of_2(u64 val);
 u32														sunder_align32(u32 current_offset, u32 alignment);
 u64														sunder_align64(u64 current_offset, u64 alignment);
 u64														sunder_compute_array_size_in_bytes(u64 type_size_in_bytes, u64 element_count);
+u64														sunder_get_os_page_size();
 
 sunder_arena_suballocation_result_t   sunder_suballocate_from_arena_debug_internal(sunder_arena_t* arena, u64 bytes, u32 alignment);
 sunder_arena_suballocation_result_t   sunder_suballocate_from_arena_internal(sunder_arena_t* arena, u64 bytes, u32 alignment);
+sunder_arena_suballocation_result_t   sunder_suballocate_from_arena_concurrent_internal(sunder_arena_t* arena, u64 bytes, u32 alignment);
 sunder_arena_result								sunder_converge_arena_chain_debug(sunder_arena_t* arena);
 
+															// folds every chained block into a single block big enough to hold everything that was suballocated, invalidates all suballocations (call at a quiet point, etc. frame boundary)
+sunder_arena_result								sunder_converge_arena_chain(sunder_arena_t* arena);
+
 															// alignment argument stands for alignment that will be used to allocate internal arena buffer with _aligned_malloc
 sunder_arena_result								sunder_allocate_arena(sunder_arena_t* arena, u64 capacity, u32 arena_alignment);
+
+															// SUNDER_ARENA_BITS_ALLOW_CHAINING_BIT in flags makes the arena link in a new block instead of running out of memory, SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT enables sunder_free_arena_suballocation (best suitable block unless SUNDER_ARENA_BITS_SUBALLOCATION_ALGORITHM_FIRST_SUITABLE_BIT is set)
+															// SUNDER_ARENA_BITS_VIRTUAL_MEMORY_BACKEND_BIT only reserves address space up front and commits it as the offset grows, allocation is O(1) and pages are zeroed by the os on first touch
+															// SUNDER_ARENA_BITS_REGISTER_STATISTICS_BIT adds the arena to sunder_query_global_arena_statistics until it is freed (the arena must not be moved in the meantime)
+															// SUNDER_ARENA_BITS_HUGE_PAGES_BIT backs the arena with 2 MB pages (MAP_HUGETLB / MEM_LARGE_PAGES), falls back to transparent huge pages and then to regular pages, which is reported through the SUNDER_ARENA_RESULT_SUCCESS_HUGE_PAGES_* results and sunder_get_arena_page_size
+sunder_arena_result								sunder_allocate_arena(sunder_arena_t* arena, const sunder_arena_allocation_data_t* allocation_data);
 sunder_arena_suballocation_result_t	sunder_suballocate_from_arena_debug(sunder_arena_t* arena, u64 bytes, u32 alignment);
 sunder_arena_suballocation_result_t	sunder_suballocate_from_arena(sunder_arena_t* arena, u64 bytes, u32 alignment);
+
+															// safe to call from many threads at once (lock free bump of the offset), never chains a new block nor reuses free blocks, do not mix with non concurrent calls on the same arena while threads are suballocating
+sunder_arena_suballocation_result_t	sunder_suballocate_from_arena_concurrent(sunder_arena_t* arena, u64 bytes, u32 alignment);
 sunder_arena_result								sunder_free_arena(sunder_arena_t* arena);
 
+															// releases every suballocation and chained block but keeps the active block, the virtual memory backend hands its pages back to the os (they read as zero afterwards, snapshot file mappings are replaced by anonymous memory first), other arenas keep their contents
+sunder_arena_result								sunder_reset_arena(sunder_arena_t* arena);
+u64														sunder_get_arena_page_size(const sunder_arena_t* arena);
+sunder_arena_statistics_t						sunder_query_arena_statistics(const sunder_arena_t* arena);
+
+															// sums the statistics of every live arena allocated with SUNDER_ARENA_BITS_REGISTER_STATISTICS_BIT
+sunder_arena_statistics_t						sunder_query_global_arena_statistics();
+
+															// tagged variants feed a per thread table (tags at or above SUNDER_ALLOCATION_TAG_COUNT are folded into the last tag), without SUNDER_ALLOCATION_TRACKING they forward to the untagged calls and the tag is dropped
+															// halloc / aligned_halloc blocks carry their size and tag in a small header and have to be released with the matching tagged free
+#if defined(SUNDER_ALLOCATION_TRACKING)
+void*													sunder_halloc_tagged(u64 bytes, u32 tag);
+void														sunder_free_tagged(void** memblock);
+void*													sunder_aligned_halloc_tagged(u64 bytes, u64 alignment, u32 tag);
+void														sunder_aligned_free_tagged(void** memblock);
+sunder_arena_result								sunder_allocate_arena_tagged(sunder_arena_t* arena, const sunder_arena_allocation_data_t* allocation_data, u32 tag);
+sunder_arena_suballocation_result_t	sunder_suballocate_from_arena_tagged(sunder_arena_t* arena, u64 bytes, u32 alignment, u32 tag);
+
+															// merges the tables of every thread (exited ones included) into statistics[SUNDER_ALLOCATION_TAG_COUNT]
+void														sunder_query_allocation_tag_statistics(sunder_allocation_tag_statistics_t* statistics);
+#else
+SUNDER_UNIQUE void*								sunder_halloc_tagged(u64 bytes, u32 tag) { (void)tag; return sunder_halloc(bytes); }
+SUNDER_UNIQUE void								sunder_free_tagged(void** memblock) { sunder_free(memblock); }
+SUNDER_UNIQUE void*								sunder_aligned_halloc_tagged(u64 bytes, u64 alignment, u32 tag) { (void)tag; return sunder_aligned_halloc(bytes, alignment); }
+SUNDER_UNIQUE void								sunder_aligned_free_tagged(void** memblock) { sunder_aligned_free(memblock); }
+SUNDER_UNIQUE sunder_arena_result			sunder_allocate_arena_tagged(sunder_arena_t* arena, const sunder_arena_allocation_data_t* allocation_data, u32 tag) { (void)tag; return sunder_allocate_arena(arena, allocation_data); }
+SUNDER_UNIQUE sunder_arena_suballocation_result_t sunder_suballocate_from_arena_tagged(sunder_arena_t* arena, u64 bytes, u32 alignment, u32 tag) { (void)tag; return sunder_suballocate_from_arena(arena, bytes, alignment); }
+SUNDER_UNIQUE void								sunder_query_allocation_tag_statistics(sunder_allocation_tag_statistics_t* statistics) { for (u32 i = 0; i < SUNDER_ALLOCATION_TAG_COUNT; i++) { statistics[i] = sunder_allocation_tag_statistics_t{}; } }
+#endif
+
+															// markers nest, rolling back releases everything suballocated after the marker was taken (including chained blocks), debug builds return SUNDER_ARENA_RESULT_OUT_OF_ORDER_ROLLBACK when an inner marker is skipped
+															// while a marker is outstanding suballocations only bump the offset (free blocks are left alone) and freeing never lowers it, resetting or converging the arena invalidates every marker
+sunder_arena_marker_t							sunder_get_arena_marker(sunder_arena_t* arena);
+sunder_arena_result								sunder_rollback_arena_to_marker(sunder_arena_t* arena, const sunder_arena_marker_t* marker);
+
+															// requires SUNDER_ARENA_BITS_ALLOW_FREE_BUFFER_USAGE_BIT, bytes has to match the size that was suballocated, only suballocations from the active block can be freed
+sunder_arena_result								sunder_free_arena_suballocation(sunder_arena_t* arena, void* data, u64 bytes);
+
+															// resizes in place when the suballocation ends at the arena offset (or is followed by a big enough free block), otherwise suballocates + copies old_bytes, path reports which one happened (SUNDER_ARENA_RESIZE_PATH_NONE and data itself when the sizes match)
+sunder_arena_resize_result_t				sunder_resize_arena_suballocation(sunder_arena_t* arena, void* data, u64 old_bytes, u64 new_bytes, u32 alignment);
+
+															// data inside a snapshot must refer to other data by offset, these convert between the two relative to arena->buffer
+u64														sunder_get_arena_pointer_offset(const sunder_arena_t* arena, const void* data);
+void*													sunder_get_arena_offset_pointer(const sunder_arena_t* arena, u64 offset);
+
+															// writes the header and the first arena->offset bytes, chained arenas have to be converged first
+sunder_arena_result								sunder_save_arena_snapshot(const sunder_arena_t* arena, const char* path);
+
+															// maps the file copy on write into a virtual memory arena of the saved capacity (or read only with no room left when SUNDER_ARENA_SNAPSHOT_BITS_READ_ONLY_BIT is set), pages fault in lazily unless the checksum is verified, free with sunder_free_arena
+sunder_arena_result								sunder_load_arena_snapshot(sunder_arena_t* arena, const char* path, u8 snapshot_flags);
+
+															// slot_size is rounded up to hold a pointer and to slot_alignment, slot blocks of slots_per_block slots are suballocated from arena on demand
+sunder_arena_result								sunder_initialize_pool(sunder_pool_t* pool, sunder_arena_t* arena, u64 slot_size, u32 slot_alignment, u32 slots_per_block);
+sunder_arena_suballocation_result_t	sunder_suballocate_from_pool(sunder_pool_t* pool);
+void														sunder_free_pool_slot(sunder_pool_t* pool, void* slot);
+
+															// returns amount of slots written to / taken from the slots array
+u32														sunder_suballocate_from_pool_bulk(sunder_pool_t* pool, void** slots, u32 count);
+void														sunder_free_pool_slots_bulk(sunder_pool_t* pool, void* const* slots, u32 count);
+
+															// thread caches are the only way to share a pool between threads, direct pool calls are not synchronized
+void														sunder_initialize_pool_thread_cache(sunder_pool_thread_cache_t* cache, sunder_pool_t* pool);
+sunder_arena_suballocation_result_t	sunder_suballocate_from_pool_thread_cache(sunder_pool_thread_cache_t* cache);
+void														sunder_free_pool_slot_to_thread_cache(sunder_pool_thread_cache_t* cache, void* slot);
+void														sunder_flush_pool_thread_cache(sunder_pool_thread_cache_t* cache);
+
+															// the ring buffer is suballocated from arena once, frames_in_flight is clamped to SUNDER_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT
+sunder_arena_result								sunder_initialize_frame_arena(sunder_frame_arena_t* frame_arena, sunder_arena_t* arena, u64 capacity, u32 frames_in_flight, u32 alignment);
+
+															// fails while a frame is being recorded or while frames_in_flight frames are still waiting to be completed
+sunder_arena_result								sunder_begin_frame_arena_frame(sunder_frame_arena_t* frame_arena, u64* frame_number);
+
+															// fails with SUNDER_ARENA_RESULT_FAILURE unless called between sunder_begin_frame_arena_frame and sunder_end_frame_arena_frame
+sunder_arena_suballocation_result_t	sunder_suballocate_from_frame_arena(sunder_frame_arena_t* frame_arena, u64 bytes, u32 alignment);
+sunder_arena_result								sunder_end_frame_arena_frame(sunder_frame_arena_t* frame_arena);
+
+															// frames may complete out of order, memory is recycled up to the oldest frame that is still pending
+sunder_arena_result								sunder_complete_frame_arena_frame(sunder_frame_arena_t* frame_arena, u64 frame_number);
+
+															// capacity and min_block_size have to be powers of 2, both the region and the tree are suballocated from arena
+sunder_arena_result								sunder_initialize_buddy_allocator(sunder_buddy_allocator_t* buddy, sunder_arena_t* arena, u64 capacity, u64 min_block_size);
+
+															// bytes are rounded up to the next power of 2 (at least min_block_size), the block is aligned to its own size relative to the region
+sunder_arena_suballocation_result_t	sunder_suballocate_from_buddy_allocator(sunder_buddy_allocator_t* buddy, u64 bytes);
+sunder_arena_result								sunder_free_buddy_allocator_block(sunder_buddy_allocator_t* buddy, void* data);
+u64														sunder_get_buddy_allocator_largest_free_block(const sunder_buddy_allocator_t* buddy);
+
+															// 1 - largest free block / free bytes, 0 when every free byte is reachable by a single suballocation
+f32														sunder_get_buddy_allocator_fragmentation(const sunder_buddy_allocator_t* buddy);
+
+sunder_arena_result								sunder_allocate_handle_arena(sunder_handle_arena_t* handle_arena, u64 capacity, u32 arena_alignment, u32 handle_capacity);
+sunder_arena_result								sunder_free_handle_arena(sunder_handle_arena_t* handle_arena);
+sunder_arena_handle_suballocation_result_t	sunder_suballocate_handle_from_arena(sunder_handle_arena_t* handle_arena, u64 bytes, u32 alignment);
+sunder_arena_result								sunder_free_arena_handle(sunder_handle_arena_t* handle_arena, sunder_arena_handle_t handle);
+
+															// nullptr for stale handles, the pointer is only valid until the next compaction step
+void*													sunder_resolve_arena_handle(const sunder_handle_arena_t* handle_arena, sunder_arena_handle_t handle);
+
+															// slides live suballocations down, moves at most byte_budget bytes (but always at least one suballocation) and returns SUNDER_ARENA_RESULT_COMPACTION_IN_PROGRESS until the pass is done
+															// a finished pass leaves no free blocks behind, alignment gaps belong to the suballocation in front of them until it is freed
+sunder_arena_result								sunder_compact_handle_arena(sunder_handle_arena_t* handle_arena, u64 byte_budget);
+
+															// min_offset_alignment has to be a power of 2 (etc. minUniformBufferOffsetAlignment), segment_count is clamped to SUNDER_UNIFORM_RING_MAX_SEGMENTS
+sunder_arena_result								sunder_initialize_uniform_ring(sunder_uniform_ring_t* ring, sunder_arena_t* arena, u64 segment_size, u32 segment_count, u64 min_offset_alignment);
+
+															// safe to call from any number of threads between two flips
+sunder_uniform_ring_suballocation_t	sunder_suballocate_from_uniform_ring(sunder_uniform_ring_t* ring, u64 bytes);
+
+															// element_count consecutive blocks, element i lives at offset + i * sunder_align64(element_size, min_offset_alignment)
+sunder_uniform_ring_suballocation_t	sunder_suballocate_array_from_uniform_ring(sunder_uniform_ring_t* ring, u64 element_size, u64 element_count);
+
+															// not thread safe, moves to the next segment and returns its index, the caller guarantees the gpu is done with it
+u32														sunder_flip_uniform_ring(sunder_uniform_ring_t* ring);
+
 u64														sunder_get_aligned_struct_allocation_size_debug(const u64* alignment_buffer, const u64* allocation_size_buffer, u64 buffer_size, u64 struct_alignment);
 u64														sunder_get_aligned_struct_allocation_size(const u64* alignment_buffer, const u64* allocation_size_buffer, u64 buffer_size, u64 struct_alignment);
 
-															// returns amount of bytes initialised
+															// returns amount of bytes initialised (zeroed)
 u64														sunder_initialize_buffer(void* buffer, u64 buffer_size, u64 starting_offset, u64 bytes_to_init);
+
+															// repeats pattern over [starting_offset, starting_offset + bytes_to_fill), pattern_size has to be 1, 2, 4, 8 or 16, the last repetition may be cut short, returns amount of bytes filled
+u64														sunder_fill_buffer(void* buffer, u64 buffer_size, u64 starting_offset, u64 bytes_to_fill, const void* pattern, u32 pattern_size);
 u64														sunder_compute_aligned_allocation_size(u64 type_size_in_bytes, u64 element_count, u64 alignment);
 
 															//	returns UINT8_MAX on failure
@@ -425,13 +858,23 @@ u64														sunder_to_bit_mask64(const sunder_bit_index_buffer64_t& storage
 
 SUNDER_DEFINE_EXISTS_FUNCTION(u32, sunder, u32, u32)
 
+															// runs the function, records the scratch arena high water mark and resets the calling thread's scratch arena afterwards
 void														sunder_invoke_function_on_thread_launch(sunder_thread_function_ptr function_ptr, void* args);
+
+															// same as sunder_invoke_function_on_thread_launch on a new thread, which also publishes the high water mark in thread->scratch_high_water_mark (thread has to outlive the function, also when detached)
 void														sunder_launch_thread(sunder_thread_t* thread, sunder_thread_function_ptr function_ptr, void* args);
 void														sunder_join_thread(sunder_thread_t* thread);
 void														sunder_detach_thread(sunder_thread_t* thread);
 void														sunder_sleep_on_current_thread_for(f64 seconds);
 sunder_thread_id									sunder_get_current_thread_id();
 
+															// calling thread's scratch arena, created on first use and freed on thread exit, returns nullptr when it could not be allocated
+sunder_arena_t*										sunder_get_thread_scratch_arena();
+void														sunder_reset_thread_scratch_arena();
+
+															// most bytes the calling thread's scratch arena had in use at once, chained blocks included
+u64														sunder_get_thread_scratch_arena_high_water_mark();
+
 void														sunder_initialize_time();
 f64														sunder_get_elapsed_time_in_seconds();
 
@@ -452,8 +895,223 @@ bool														sunder_compare_strings(cstring_literal* str1, u32 str1_size,
 
 SUNDER_DEFINE_QUERY_BUFFER_INDEX_FUNCTION(u32, sunder, u32, u32)
 
+															// 16 to 64 elements are compared per iteration (sse2 / avx2 picked at runtime), floats compare like operator== does (nan never matches)
+SUNDER_DEFINE_SEARCH_FUNCTIONS(u8, u8)
+SUNDER_DEFINE_SEARCH_FUNCTIONS(u16, u16)
+SUNDER_DEFINE_SEARCH_FUNCTIONS(u32, u32)
+SUNDER_DEFINE_SEARCH_FUNCTIONS(u64, u64)
+SUNDER_DEFINE_SEARCH_FUNCTIONS(f32, f32)
+SUNDER_DEFINE_SEARCH_FUNCTIONS(f64, f64)
+
+															// parallel variants split the buffer into SUNDER_FILTER_MIN_ELEMENTS_PER_THREAD+ element chunks, filter them on worker threads and close the gaps afterwards
+SUNDER_DEFINE_FILTER_FUNCTIONS(u8, u8)
+SUNDER_DEFINE_FILTER_FUNCTIONS(u16, u16)
+SUNDER_DEFINE_FILTER_FUNCTIONS(u32, u32)
+SUNDER_DEFINE_FILTER_FUNCTIONS(u64, u64)
+SUNDER_DEFINE_FILTER_FUNCTIONS(f32, f32)
+SUNDER_DEFINE_FILTER_FUNCTIONS(f64, f64)
+
+// introsort over the inclusive range [starting_index, ending_index], comparison_function(a, b) returns true when *a has to go before *b
+// comparison_type can be a function pointer or any callable, callables with their own type (lambdas) get inlined into the instantiation
+template<typename type, typename comparison_type>
+SUNDER_UNIQUE void sunder_insertion_sort(type* buffer, i64 starting_index, i64 ending_index, comparison_type comparison_function)
+{
+	for (i64 i = starting_index + 1; i <= ending_index; i++)
+	{
+		const type val = buffer[i];
+		i64 j = i;
+
+		for (; j > starting_index && comparison_function(&val, &buffer[j - 1]); j--)
+		{
+			buffer[j] = buffer[j - 1];
+		}
+
+		buffer[j] = val;
+	}
+}
+
+// gives up after SUNDER_SORT_PARTIAL_INSERTION_SORT_MAX_MOVES moved elements, used to finish (nearly) sorted partitions in linear time
+template<typename type, typename comparison_type>
+SUNDER_UNIQUE bool sunder_partial_insertion_sort(type* buffer, i64 starting_index, i64 ending_index, comparison_type comparison_function)
+{
+	u32 moves = 0;
+
+	for (i64 i = starting_index + 1; i <= ending_index; i++)
+	{
+		if (!comparison_function(&buffer[i], &buffer[i - 1])) { continue; }
+
+		const type val = buffer[i];
+		i64 j = i;
+
+		for (; j > starting_index && comparison_function(&val, &buffer[j - 1]); j--)
+		{
+			buffer[j] = buffer[j - 1];
+		}
+
+		buffer[j] = val;
+		moves += (u32)(i - j);
+
+		if (moves > SUNDER_SORT_PARTIAL_INSERTION_SORT_MAX_MOVES) { return false; }
+	}
+
+	return true;
+}
+
+template<typename type, typename comparison_type>
+SUNDER_UNIQUE void sunder_sift_down_heap(type* heap, i64 root, i64 size, comparison_type comparison_function)
+{
+	for (;;)
+	{
+		i64 child = root * 2 + 1;
+		if (child >= size) { return; }
+		if (child + 1 < size && comparison_function(&heap[child], &heap[child + 1])) { child++; }
+		if (!comparison_function(&heap[root], &heap[child])) { return; }
+
+		const type temp = heap[root];
+		heap[root] = heap[child];
+		heap[child] = temp;
+		root = child;
+	}
+}
+
+template<typename type, typename comparison_type>
+SUNDER_UNIQUE void sunder_heap_sort(type* buffer, i64 starting_index, i64 ending_index, comparison_type comparison_function)
+{
+	type* heap = buffer + starting_index;
+	const i64 count = ending_index - starting_index + 1;
+
+	for (i64 i = count / 2 - 1; i >= 0; i--)
+	{
+		sunder_sift_down_heap(heap, i, count, comparison_function);
+	}
+
+	for (i64 size = count - 1; size > 0; size--)
+	{
+		const type top = heap[0];
+		heap[0] = heap[size];
+		heap[size] = top;
+
+		sunder_sift_down_heap(heap, 0, size, comparison_function);
+	}
+}
+
+template<typename type, typename comparison_type>
+SUNDER_UNIQUE void sunder_sort_three(type* buffer, i64 a, i64 b, i64 c, comparison_type comparison_function)
+{
+	if (comparison_function(&buffer[b], &buffer[a])) { const type temp = buffer[a]; buffer[a] = buffer[b]; buffer[b] = temp; }
+	if (comparison_function(&buffer[c], &buffer[b])) { const type temp = buffer[b]; buffer[b] = buffer[c]; buffer[c] = temp; }
+	if (comparison_function(&buffer[b], &buffer[a])) { const type temp = buffer[a]; buffer[a] = buffer[b]; buffer[b] = temp; }
+}
+
+// median of three (ninther above SUNDER_SORT_NINTHER_THRESHOLD) pivot, hoare partitioning so runs of equal elements split evenly,
+// the smaller side is recursed into and the larger one looped on (O(log n) stack), heap sort takes over once the depth limit is hit,
+// depth_limit is what is left of the budget of the whole sort so the worst case stays O(n log n)
+template<typename type, typename comparison_type>
+SUNDER_UNIQUE void sunder_introsort_internal(type* buffer, i64 starting_index, i64 ending_index, u32 depth_limit, comparison_type comparison_function)
+{
+	while (ending_index - starting_index + 1 > SUNDER_SORT_INSERTION_SORT_THRESHOLD)
+	{
+		if (depth_limit == 0)
+		{
+			sunder_heap_sort(buffer, starting_index, ending_index, comparison_function);
+			return;
+		}
+
+		depth_limit--;
+
+		const i64 count = ending_index - starting_index + 1;
+		const i64 middle = starting_index + count / 2;
+
+		if (count > SUNDER_SORT_NINTHER_THRESHOLD)
+		{
+			sunder_sort_three(buffer, starting_index, middle, ending_index, comparison_function);
+			sunder_sort_three(buffer, starting_index + 1, middle - 1, ending_index - 1, comparison_function);
+			sunder_sort_three(buffer, starting_index + 2, middle + 1, ending_index - 2, comparison_function);
+			sunder_sort_three(buffer, middle - 1, middle, middle + 1, comparison_function);
+		}
+
+		else
+		{
+			sunder_sort_three(buffer, starting_index, middle, ending_index, comparison_function);
+		}
+
+		const type pivot = buffer[middle];
+		buffer[middle] = buffer[starting_index];
+		buffer[starting_index] = pivot;
+
+		i64 i = starting_index;
+		i64 j = ending_index + 1;
+		bool swapped = false;
+
+		for (;;)
+		{
+			while (++i <= ending_index && comparison_function(&buffer[i], &pivot)) {}
+			while (comparison_function(&pivot, &buffer[--j])) {}
+
+			if (i >= j) { break; }
+
+			const type temp = buffer[i];
+			buffer[i] = buffer[j];
+			buffer[j] = temp;
+			swapped = true;
+		}
+
+		buffer[starting_index] = buffer[j];
+		buffer[j] = pivot;
+
+		// nothing had to move, the input is probably (nearly) sorted already
+		if (!swapped && sunder_partial_insertion_sort(buffer, starting_index, j - 1, comparison_function) && sunder_partial_insertion_sort(buffer, j + 1, ending_index, comparison_function)) { return; }
+
+		if (j - starting_index < ending_index - j)
+		{
+			sunder_introsort_internal(buffer, starting_index, j - 1, depth_limit, comparison_function);
+			starting_index = j + 1;
+		}
+
+		else
+		{
+			sunder_introsort_internal(buffer, j + 1, ending_index, depth_limit, comparison_function);
+			ending_index = j - 1;
+		}
+	}
+
+	sunder_insertion_sort(buffer, starting_index, ending_index, comparison_function);
+}
+
+// the depth limit (2 * floor(log2 n)) is computed once for the whole range
+template<typename type, typename comparison_type>
+SUNDER_UNIQUE void sunder_introsort(type* buffer, i64 starting_index, i64 ending_index, comparison_type comparison_function)
+{
+	if (buffer == nullptr || ending_index <= starting_index) { return; }
+
+	u32 depth_limit = 0;
+
+	for (u64 count = (u64)(ending_index - starting_index + 1); count > 1; count >>= 1)
+	{
+		depth_limit += 2;
+	}
+
+	sunder_introsort_internal(buffer, starting_index, ending_index, depth_limit, comparison_function);
+}
+
 SUNDER_DEFINE_QUICK_SORT_PARTITION_FUNCTION(sunder_arena_free_memory_block_t, arena_free_memory_block, sunder)
 SUNDER_DEFINE_QUICK_SORT_FUNCTION(sunder_arena_free_memory_block_t, arena_free_memory_block, sunder)
+SUNDER_DEFINE_QUICK_SORT_PARTITION_FUNCTION(sunder_buffer_copy_data_t, buffer_copy_data, sunder)
+SUNDER_DEFINE_QUICK_SORT_FUNCTION(sunder_buffer_copy_data_t, buffer_copy_data, sunder)
+
+															// 11 bit digits need fewer passes for 32 / 64 bit keys (3 / 6 instead of 4 / 8) at 2048 instead of 256 histogram entries per pass
+SUNDER_DEFINE_RADIX_SORT_FUNCTIONS(u16, u16)
+SUNDER_DEFINE_RADIX_SORT_FUNCTIONS(u32, u32)
+SUNDER_DEFINE_RADIX_SORT_FUNCTIONS(u64, u64)
+SUNDER_DEFINE_RADIX_SORT_FUNCTIONS(f32, f32)
+SUNDER_DEFINE_RADIX_SORT_FUNCTIONS(sunder_arena_free_memory_block_t, arena_free_memory_block)
+
+															// falls back to sunder_introsort on the calling thread (no scratch needed) below SUNDER_PARALLEL_SORT_MIN_ELEMENTS_PER_THREAD * 2 elements or with thread_count <= 1
+SUNDER_DEFINE_PARALLEL_SORT_FUNCTION(u32, u32)
+SUNDER_DEFINE_PARALLEL_SORT_FUNCTION(u64, u64)
+SUNDER_DEFINE_PARALLEL_SORT_FUNCTION(f32, f32)
+SUNDER_DEFINE_PARALLEL_SORT_FUNCTION(f64, f64)
+SUNDER_DEFINE_PARALLEL_SORT_FUNCTION(sunder_arena_free_memory_block_t, arena_free_memory_block)
 
 void														sunder_log_string(const sunder_string_t* string);
 u64														sunder_update_aligned_value_u64(u64 val, u64 update_val, u32 alignment);